@@ -0,0 +1,454 @@
+// Алгоритм Ахо-Корасик (Aho-Corasick)
+// Поиск МНОЖЕСТВА образцов за один проход по тексту
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНЫЕ ФУНКЦИИ:
+//   bool AC_Build(ACAutomaton* ac, const char* const* patterns,
+//                 const size_t* lens, int count)   - построить автомат
+//   int  AC_Search(const ACAutomaton* ac, const char* text, size_t n,
+//                  AC_Callback cb, void* ctx)      - поиск во всём тексте
+//   void AC_StreamInit(ACStream* s, const ACAutomaton* ac)
+//   int  AC_Feed(ACStream* s, const char* chunk, size_t len,
+//                AC_Callback cb, void* ctx)        - потоковый поиск
+//   void AC_Destroy(ACAutomaton* ac)
+//
+// ИДЕЯ - обобщение префикс-функции КМП на бор (trie):
+//   1. Строим бор из всех образцов
+//   2. Для каждой вершины считаем суффиксную ссылку (fail) - аналог lps[]:
+//      вершину бора, соответствующую наибольшему собственному суффиксу
+//      текущей строки. Считаем обходом в ширину (BFS)
+//   3. Отсутствующие переходы заменяем переходами из fail-вершины -
+//      получается полный ДКА: ОДИН переход на символ, без откатов
+//   4. Словарная ссылка (outLink) - ближайшая по fail-цепочке вершина,
+//      где заканчивается образец: так находим образцы-суффиксы ("he" в "she")
+//
+// КОМПАКТНАЯ ТАБЛИЦА ПЕРЕХОДОВ:
+//   - Байты, не встречающиеся ни в одном образце, ведут себя одинаково
+//     → все попадают в класс 0 (классы эквивалентности алфавита)
+//   - Таблица next[состояние * nclasses + класс] плотная: переход -
+//     два обращения к памяти, без ветвлений
+//   - Для словаря из английских слов nclasses ~ 30-60 вместо 256
+//
+// ПОТОКОВЫЙ РЕЖИМ:
+//   Состояние автомата - одно число, поэтому текст можно подавать
+//   кусками: совпадения на границе кусков не теряются, позиции
+//   считаются от начала потока (64 бита)
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Обработчик совпадения: pattern - номер образца, pos - позиция начала
+// совпадения от начала потока. Ненулевой результат останавливает поиск
+typedef int (*AC_Callback)(int pattern, uint64_t pos, void* ctx);
+
+typedef struct {
+    int* next;               // переходы: next[s * nclasses + cls[byte]]
+    unsigned char cls[256];  // класс эквивалентности каждого байта
+    int nclasses;            // количество классов (0 - "чужие" байты)
+    int nstates;             // количество состояний (0 - корень)
+    int* out;                // образец, оканчивающийся в состоянии, или -1
+    int* outLink;            // словарная ссылка (0 - нет)
+    unsigned char* report;   // 1, если в состоянии есть что сообщать
+    int* sameNext;           // следующий образец с той же строкой, или -1
+    int* patLen;             // длины образцов
+    int npatterns;
+} ACAutomaton;
+
+typedef struct {
+    const ACAutomaton* ac;
+    int state;               // текущее состояние автомата
+    uint64_t offset;         // сколько байт потока уже обработано
+} ACStream;
+
+// Добавить новое состояние (строку таблицы переходов)
+// -1 - не хватило памяти (массивы автомата остаются корректными)
+static int AC_NewState(ACAutomaton* ac, int* capacity) {
+    if (ac->nstates == *capacity) {
+        int cap = *capacity * 2;
+        // realloc через временный указатель: при отказе старый блок цел
+        int* next = realloc(ac->next, sizeof(int) * (size_t)cap * ac->nclasses);
+        if (!next) return -1;
+        ac->next = next;
+        int* out = realloc(ac->out, sizeof(int) * (size_t)cap);
+        if (!out) return -1;
+        ac->out = out;
+        int* outLink = realloc(ac->outLink, sizeof(int) * (size_t)cap);
+        if (!outLink) return -1;
+        ac->outLink = outLink;
+        *capacity = cap;
+    }
+    int s = ac->nstates++;
+    for (int c = 0; c < ac->nclasses; c++) {
+        ac->next[(size_t)s * ac->nclasses + c] = -1;
+    }
+    ac->out[s] = -1;
+    ac->outLink[s] = 0;
+    return s;
+}
+
+void AC_Destroy(ACAutomaton* ac) {
+    free(ac->next);
+    free(ac->out);
+    free(ac->outLink);
+    free(ac->sameNext);
+    free(ac->patLen);
+    free(ac->report);
+    memset(ac, 0, sizeof(*ac));
+}
+
+// Неудачное построение: освободить временные массивы и всё построенное
+static bool AC_BuildFailed(ACAutomaton* ac, int* a, int* b, int* c) {
+    free(a);
+    free(b);
+    free(c);
+    AC_Destroy(ac);
+    return false;
+}
+
+// Построение автомата по набору образцов (могут содержать нулевые байты)
+// Пустые образцы пропускаются. Возвращает false, если нет ни одного образца
+// или не хватило памяти (автомат тогда пуст - AC_Destroy безопасен)
+bool AC_Build(ACAutomaton* ac, const char* const* patterns,
+              const size_t* lens, int count) {
+    memset(ac, 0, sizeof(*ac));
+
+    // ЭТАП 1: Классы эквивалентности - каждый байт из образцов
+    // получает свой класс, остальные байты - класс 0
+    bool used[256] = {false};
+    for (int p = 0; p < count; p++) {
+        for (size_t i = 0; i < lens[p]; i++) {
+            used[(unsigned char)patterns[p][i]] = true;
+        }
+    }
+    ac->nclasses = 1;
+    for (int b = 0; b < 256; b++) {
+        ac->cls[b] = used[b] ? (unsigned char)ac->nclasses++ : 0;
+    }
+    // 256 различных байт дают 257 классов - класс 0 тогда просто не нужен
+    if (ac->nclasses > 256) {
+        ac->nclasses = 256;
+        for (int b = 0; b < 256; b++) {
+            ac->cls[b] = (unsigned char)b;
+        }
+    }
+
+    // ЭТАП 2: Бор
+    int capacity = 64;
+    ac->next = malloc(sizeof(int) * (size_t)capacity * ac->nclasses);
+    ac->out = malloc(sizeof(int) * (size_t)capacity);
+    ac->outLink = malloc(sizeof(int) * (size_t)capacity);
+    ac->sameNext = malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    ac->patLen = malloc(sizeof(int) * (size_t)(count > 0 ? count : 1));
+    ac->npatterns = count;
+    if (!ac->next || !ac->out || !ac->outLink || !ac->sameNext || !ac->patLen) {
+        return AC_BuildFailed(ac, NULL, NULL, NULL);
+    }
+    AC_NewState(ac, &capacity);  // корень (место под него уже выделено)
+
+    bool any = false;
+    for (int p = 0; p < count; p++) {
+        ac->patLen[p] = (int)lens[p];
+        ac->sameNext[p] = -1;
+        if (lens[p] == 0) {
+            continue;
+        }
+        any = true;
+
+        int s = 0;
+        for (size_t i = 0; i < lens[p]; i++) {
+            int c = ac->cls[(unsigned char)patterns[p][i]];
+            int t = ac->next[(size_t)s * ac->nclasses + c];
+            if (t < 0) {
+                t = AC_NewState(ac, &capacity);
+                if (t < 0) {
+                    return AC_BuildFailed(ac, NULL, NULL, NULL);
+                }
+                ac->next[(size_t)s * ac->nclasses + c] = t;
+            }
+            s = t;
+        }
+        // Одинаковые образцы связываем в цепочку
+        ac->sameNext[p] = ac->out[s];
+        ac->out[s] = p;
+    }
+
+    // ЭТАП 3: Перенумерация состояний в порядке обхода в ширину.
+    // Верхние уровни бора посещаются чаще всего - теперь их строки таблицы
+    // лежат подряд в начале и держатся в кэше
+    int* queue = malloc(sizeof(int) * (size_t)ac->nstates);
+    int* order = malloc(sizeof(int) * (size_t)ac->nstates);  // старый → новый
+    if (!queue || !order) {
+        return AC_BuildFailed(ac, queue, order, NULL);
+    }
+    int head = 0, tail = 0;
+    queue[tail++] = 0;
+    while (head < tail) {
+        int u = queue[head];
+        order[u] = head++;
+        for (int c = 0; c < ac->nclasses; c++) {
+            int v = ac->next[(size_t)u * ac->nclasses + c];
+            if (v >= 0) {
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    int* next = malloc(sizeof(int) * (size_t)ac->nstates * ac->nclasses);
+    int* out = malloc(sizeof(int) * (size_t)ac->nstates);
+    if (!next || !out) {
+        free(next);
+        return AC_BuildFailed(ac, queue, order, out);
+    }
+    for (int u = 0; u < ac->nstates; u++) {
+        const int* oldRow = &ac->next[(size_t)u * ac->nclasses];
+        int* newRow = &next[(size_t)order[u] * ac->nclasses];
+        for (int c = 0; c < ac->nclasses; c++) {
+            newRow[c] = (oldRow[c] >= 0) ? order[oldRow[c]] : -1;
+        }
+        out[order[u]] = ac->out[u];
+    }
+    free(ac->next);
+    free(ac->out);
+    free(order);
+    ac->next = next;
+    ac->out = out;
+
+    // ЭТАП 4: Суффиксные ссылки и полный ДКА (обход в ширину).
+    // После перенумерации порядок BFS - это просто 1, 2, 3, ...
+    int* fail = malloc(sizeof(int) * (size_t)ac->nstates);
+    if (!fail) {
+        return AC_BuildFailed(ac, queue, NULL, NULL);
+    }
+    fail[0] = 0;
+    ac->outLink[0] = 0;
+    for (int c = 0; c < ac->nclasses; c++) {
+        int v = ac->next[c];
+        if (v < 0) {
+            ac->next[c] = 0;        // из корня по "чужому" символу - в корень
+        } else {
+            fail[v] = 0;
+            ac->outLink[v] = 0;
+        }
+    }
+
+    for (int u = 1; u < ac->nstates; u++) {
+        int* row = &ac->next[(size_t)u * ac->nclasses];
+        const int* failRow = &ac->next[(size_t)fail[u] * ac->nclasses];
+
+        for (int c = 0; c < ac->nclasses; c++) {
+            int v = row[c];
+            if (v < 0) {
+                // Перехода в боре нет - берём переход fail-вершины
+                // (она ближе к корню и уже обработана)
+                row[c] = failRow[c];
+            } else {
+                fail[v] = failRow[c];
+                ac->outLink[v] = (ac->out[fail[v]] >= 0) ? fail[v]
+                                                         : ac->outLink[fail[v]];
+            }
+        }
+    }
+
+    ac->report = malloc((size_t)ac->nstates);
+    if (!ac->report) {
+        return AC_BuildFailed(ac, queue, fail, NULL);
+    }
+    for (int u = 0; u < ac->nstates; u++) {
+        ac->report[u] = (ac->out[u] >= 0 || ac->outLink[u] != 0);
+    }
+
+    free(fail);
+    free(queue);
+    return any;
+}
+
+void AC_StreamInit(ACStream* s, const ACAutomaton* ac) {
+    s->ac = ac;
+    s->state = 0;
+    s->offset = 0;
+}
+
+// Сообщить обо всех образцах, оканчивающихся в состоянии s
+// end - позиция (от начала потока) байта, на котором они закончились
+static int AC_Report(const ACAutomaton* ac, int s, uint64_t end,
+                     AC_Callback cb, void* ctx) {
+    if (ac->out[s] < 0) {
+        s = ac->outLink[s];
+    }
+    while (s != 0) {
+        for (int p = ac->out[s]; p >= 0; p = ac->sameNext[p]) {
+            if (cb(p, end + 1 - (uint64_t)ac->patLen[p], ctx)) {
+                return 1;
+            }
+        }
+        s = ac->outLink[s];
+    }
+    return 0;
+}
+
+// Обработать очередной кусок потока
+// Возвращает 1, если обработчик остановил поиск, иначе 0
+int AC_Feed(ACStream* s, const char* chunk, size_t len,
+            AC_Callback cb, void* ctx) {
+    const ACAutomaton* ac = s->ac;
+    const unsigned char* p = (const unsigned char*)chunk;
+    const int* next = ac->next;
+    const unsigned char* cls = ac->cls;
+    const unsigned char* report = ac->report;
+    const int nclasses = ac->nclasses;
+    int state = s->state;
+
+    for (size_t i = 0; i < len; i++) {
+        // Один табличный переход на байт - без откатов по fail-ссылкам
+        state = next[(size_t)state * nclasses + cls[p[i]]];
+
+        if (report[state]) {
+            if (AC_Report(ac, state, s->offset + i, cb, ctx)) {
+                s->state = state;
+                s->offset += i + 1;
+                return 1;
+            }
+        }
+    }
+
+    s->state = state;
+    s->offset += len;
+    return 0;
+}
+
+// Поиск во всём тексте сразу
+int AC_Search(const ACAutomaton* ac, const char* text, size_t n,
+              AC_Callback cb, void* ctx) {
+    ACStream s;
+    AC_StreamInit(&s, ac);
+    return AC_Feed(&s, text, n, cb, ctx);
+}
+
+// ============ СЛОЖНОСТЬ ============
+// Построение: O(L · σ'), где L - суммарная длина образцов,
+//             σ' - число классов эквивалентности (σ' ≤ 257)
+// Поиск: O(n + z), где n - длина текста, z - число совпадений
+//        НЕ зависит от количества образцов!
+// Память: O(L · σ') - плотная таблица переходов
+//
+// Сравнение с КМП для k образцов:
+// - КМП в цикле: O(k · n) - каждый образец - отдельный проход по тексту
+// - Ахо-Корасик: O(n) - один проход для всех образцов сразу
+// - Для 50K ключевых слов разница - десятки тысяч раз
+//
+// Особенности:
+// - При k = 1 автомат - это в точности ДКА префикс-функции КМП
+// - Работает с произвольными байтами (UTF-8, бинарные данные)
+// - Таблица на 500K состояний × 40 классов ~ 80 МБ; если не помещается
+//   в кэш, скорость ограничена промахами по памяти. Нумерация состояний
+//   в порядке BFS держит горячие верхние уровни бора в кэше
+// - Используется в grep -F, антивирусах, фильтрах логов
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <time.h>
+#include "kmp.c"
+
+static int printMatch(int pattern, uint64_t pos, void* ctx) {
+    const char* const* names = ctx;
+    printf("Найдено \"%s\" на позиции %llu\n", names[pattern],
+           (unsigned long long)pos);
+    return 0;
+}
+
+static int countMatch(int pattern, uint64_t pos, void* ctx) {
+    (void)pattern; (void)pos;
+    (*(long long*)ctx)++;
+    return 0;
+}
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    printf("=== Алгоритм Ахо-Корасик ===\n\n");
+
+    // Тест 1: Классический пример - образцы-суффиксы друг друга
+    const char* words[] = {"he", "she", "his", "hers"};
+    size_t lens[] = {2, 3, 3, 4};
+    ACAutomaton ac;
+    AC_Build(&ac, words, lens, 4);
+
+    const char* text1 = "ushers";
+    printf("Тест 1: Ищем {he, she, his, hers} в \"%s\"\n", text1);
+    AC_Search(&ac, text1, strlen(text1), printMatch, words);
+    // she@1, he@2, hers@2
+    printf("\n");
+
+    // Тест 2: Поток кусками - совпадение на границе не теряется
+    printf("Тест 2: Поток \"us\" + \"he\" + \"rs\"\n");
+    ACStream st;
+    AC_StreamInit(&st, &ac);
+    AC_Feed(&st, "us", 2, printMatch, words);
+    AC_Feed(&st, "he", 2, printMatch, words);
+    AC_Feed(&st, "rs", 2, printMatch, words);
+    printf("\n");
+    AC_Destroy(&ac);
+
+    // Тест 3: Бенчмарк - 50K ключевых слов против KMPSearch в цикле
+    size_t n = 64 << 20;
+    char* text = malloc(n + 1);
+    srand(1);
+    for (size_t i = 0; i < n; i++)
+        text[i] = 'a' + rand() % 26;
+    text[n] = '\0';
+
+    int k = 50000, m = 8;
+    char** pats = malloc(sizeof(char*) * k);
+    size_t* plen = malloc(sizeof(size_t) * k);
+    for (int i = 0; i < k; i++) {
+        pats[i] = malloc(m + 1);
+        for (int j = 0; j < m; j++)
+            pats[i][j] = 'a' + rand() % 26;
+        pats[i][m] = '\0';
+        plen[i] = m;
+    }
+
+    double t0 = now();
+    AC_Build(&ac, (const char* const*)pats, plen, k);
+    double t1 = now();
+    long long found = 0;
+    AC_Search(&ac, text, n, countMatch, &found);
+    double t2 = now();
+    printf("Тест 3: Ахо-Корасик, %d образцов, %zu МБ текста\n", k, n >> 20);
+    printf("Построение: %.3f с, состояний: %d, классов: %d\n",
+           t1 - t0, ac.nstates, ac.nclasses);
+    printf("Поиск: %.3f с, %.2f ГБ/с, совпадений: %lld\n",
+           t2 - t1, n / (t2 - t1) / 1e9, found);
+
+    // КМП: замеряем 100 образцов и пересчитываем на все k образцов
+    int sample = 100;
+    size_t kmpFound = 0;
+    double t3 = now();
+    for (int i = 0; i < sample; i++)
+        KMPSearch(text, n, pats[i], plen[i], Search_Count, &kmpFound);
+    double t4 = now();
+    double kmpTotal = (t4 - t3) / sample * k;
+    printf("KMPSearch в цикле: ~%.0f с на %d образцов, %.6f ГБ/с\n",
+           kmpTotal, k, n / kmpTotal / 1e9);
+    printf("Ускорение: ~%.0fx\n", kmpTotal / (t2 - t1));
+
+    AC_Destroy(&ac);
+    for (int i = 0; i < k; i++)
+        free(pats[i]);
+    free(pats);
+    free(plen);
+    free(text);
+    return 0;
+}
+*/
@@ -0,0 +1,357 @@
+// Нечёткий поиск: все вхождения с расстоянием редактирования ≤ k
+// Бит-параллельный алгоритм Майерса (Myers, 1999)
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНЫЕ ФУНКЦИИ:
+//   size_t approxSearch(const char* text, size_t n, const char* pattern,
+//                       size_t m, size_t k, SearchCallback cb, void* ctx)
+//     - выбирает myersSearch (m ≤ 64) или myersSearchBlocked (m > 64)
+//   size_t myersSearch(...)         - паттерн в одном машинном слове
+//   size_t myersSearchBlocked(...)  - паттерн любой длины, блоки по 64 бита
+//
+//   Интерфейс как у точных алгоритмов (search.h), но pos в cb - позиция
+//   ПОСЛЕДНЕГО символа вхождения: начало при ошибках неоднозначно
+//   ("colour" ≈ "color": вхождение может начинаться на символ раньше/позже)
+//
+// РАССТОЯНИЕ РЕДАКТИРОВАНИЯ (Левенштейна):
+//   Минимальное число вставок, удалений и замен символов
+//   "iphone" → "iphnoe": 2 (две замены)
+//
+// ДИНАМИКА (основа):
+//   D[i][j] - расстояние между pattern[0..i) и лучшей подстрокой текста,
+//   оканчивающейся в j. D[0][j] = 0 (вхождение может начаться где угодно)
+//   D[i][j] = min(D[i-1][j-1] + (p[i-1] != t[j-1]),
+//                 D[i-1][j] + 1, D[i][j-1] + 1)
+//   Вхождение оканчивается в j, если D[m][j] ≤ k
+//   Прямой подсчёт - O(nm)
+//
+// БИТОВЫЙ ПАРАЛЛЕЛИЗМ:
+//   Соседние клетки столбца отличаются на -1, 0 или +1. Храним не числа,
+//   а РАЗНОСТИ - по биту на строку:
+//     Pv: бит i = 1, если D[i][j] - D[i-1][j] = +1
+//     Mv: бит i = 1, если D[i][j] - D[i-1][j] = -1
+//   Переход к следующему столбцу - десяток операций над словами,
+//   т.е. 64 клетки динамики за раз. Сам D[m][j] (score) ведём счётчиком
+//
+//   Peq[c] - маска строк, где pattern[i] == c (как в Shift-And)
+//
+// ДЛИННЫЕ ПАТТЕРНЫ (m > 64):
+//   Столбец делится на блоки по 64 строки, блок передаёт следующему
+//   горизонтальную разность своей нижней строки (-1, 0, +1) - как перенос
+//   при сложении длинных чисел
+//   Отсечение Укконена: блоки, где все клетки > k, не считаются.
+//   Обычно активны лишь первые ⌈k/64⌉ блоков → O(n·k/64), а не O(n·m/64)
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "search.h"
+
+#define MYERS_WORD 64
+
+// Паттерн до 64 символов: весь столбец динамики в одном слове
+size_t myersSearch(const char* text, size_t n, const char* pattern, size_t m,
+                   size_t k, SearchCallback cb, void* ctx) {
+    if (m == 0 || m > MYERS_WORD) {
+        return 0;
+    }
+
+    const unsigned char* t = (const unsigned char*)text;
+    const unsigned char* p = (const unsigned char*)pattern;
+
+    uint64_t peq[256] = {0};
+    for (size_t i = 0; i < m; i++) {
+        peq[p[i]] |= (uint64_t)1 << i;
+    }
+
+    uint64_t high = (uint64_t)1 << (m - 1);  // бит строки m
+    uint64_t pv = ~(uint64_t)0;              // D[i][0] = i: все разности +1
+    uint64_t mv = 0;
+    size_t score = m;                        // D[m][j]
+    size_t found = 0;
+
+    for (size_t j = 0; j < n; j++) {
+        uint64_t eq = peq[t[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+
+        // Горизонтальные разности D[i][j] - D[i][j-1]
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        if (ph & high) {
+            score++;
+        } else if (mh & high) {
+            score--;
+        }
+
+        // Сдвиг на строку вниз; D[0][j] = 0 → перенос в строку 0 нулевой
+        ph <<= 1;
+        mh <<= 1;
+
+        // Новые вертикальные разности
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        if (score <= k) {
+            found++;
+            if (cb(j, ctx)) {
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+// Состояние одного блока из 64 строк
+typedef struct {
+    uint64_t pv;
+    uint64_t mv;
+    uint64_t high;      // бит нижней строки блока
+    size_t score;       // D в нижней строке блока
+    size_t rows;        // число строк в блоке (у последнего может быть < 64)
+} MyersBlock;
+
+// Продвинуть блок на один столбец
+// hin - горизонтальная разность над блоком (-1, 0, +1), возвращает разность
+// его нижней строки - она станет hin следующего блока
+static int myersAdvanceBlock(MyersBlock* b, uint64_t eq, int hin) {
+    uint64_t pv = b->pv, mv = b->mv;
+    uint64_t xv = eq | mv;
+    if (hin < 0) {
+        eq |= 1;  // разность -1 сверху действует как совпадение в строке 0
+    }
+    uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+
+    int hout = 0;
+    if (ph & b->high) {
+        hout = 1;
+    } else if (mh & b->high) {
+        hout = -1;
+    }
+
+    ph <<= 1;
+    mh <<= 1;
+    if (hin < 0) {
+        mh |= 1;
+    } else if (hin > 0) {
+        ph |= 1;
+    }
+
+    b->pv = mh | ~(xv | ph);
+    b->mv = ph & xv;
+    return hout;
+}
+
+// Блок в начальном состоянии: разности +1 сверху вниз
+static void myersResetBlock(MyersBlock* b) {
+    b->pv = ~(uint64_t)0;
+    b->mv = 0;
+}
+
+// Паттерн любой длины: блоки по 64 строки с отсечением Укконена
+size_t myersSearchBlocked(const char* text, size_t n, const char* pattern,
+                          size_t m, size_t k, SearchCallback cb, void* ctx) {
+    if (m == 0) {
+        return 0;
+    }
+
+    const unsigned char* t = (const unsigned char*)text;
+    const unsigned char* p = (const unsigned char*)pattern;
+    size_t nblocks = (m + MYERS_WORD - 1) / MYERS_WORD;
+    size_t last = nblocks - 1;
+
+    // peq[c * nblocks + b] - маска символа c в блоке b
+    uint64_t* peq = calloc(256 * nblocks, sizeof(uint64_t));
+    MyersBlock* blocks = malloc(sizeof(MyersBlock) * nblocks);
+    for (size_t i = 0; i < m; i++) {
+        peq[p[i] * nblocks + i / MYERS_WORD] |= (uint64_t)1 << (i % MYERS_WORD);
+    }
+    for (size_t b = 0; b < nblocks; b++) {
+        blocks[b].rows = (b == last) ? m - b * MYERS_WORD : MYERS_WORD;
+        blocks[b].high = (uint64_t)1 << (blocks[b].rows - 1);
+        myersResetBlock(&blocks[b]);
+        blocks[b].score = b * MYERS_WORD + blocks[b].rows;
+    }
+
+    // y - последний активный блок: ниже него все клетки заведомо > k
+    size_t y = (k + MYERS_WORD - 1) / MYERS_WORD;
+    y = (y > 0) ? y - 1 : 0;
+    if (y > last) {
+        y = last;
+    }
+
+    size_t found = 0;
+    for (size_t j = 0; j < n; j++) {
+        const uint64_t* eq = peq + t[j] * nblocks;
+
+        int carry = 0;
+        for (size_t b = 0; b <= y; b++) {
+            carry = myersAdvanceBlock(&blocks[b], eq[b], carry);
+            blocks[b].score += carry;
+        }
+
+        // Нижняя строка блока y в прошлом столбце ≤ k и верх блока y+1
+        // может уменьшиться → блок y+1 становится активным. Его прошлый
+        // столбец считаем "по умолчанию": разности +1 под блоком y
+        if (y < last && blocks[y].score - carry <= k &&
+            ((eq[y + 1] & 1) || carry < 0)) {
+            y++;
+            myersResetBlock(&blocks[y]);
+            blocks[y].score = blocks[y - 1].score - carry + blocks[y].rows +
+                              myersAdvanceBlock(&blocks[y], eq[y], carry);
+        } else {
+            // Нижняя строка ≥ k + 64 → во всём блоке клетки > k
+            while (y > 0 && blocks[y].score >= k + MYERS_WORD) {
+                y--;
+            }
+        }
+
+        if (y == last && blocks[last].score <= k) {
+            found++;
+            if (cb(j, ctx)) {
+                break;
+            }
+        }
+    }
+
+    free(peq);
+    free(blocks);
+    return found;
+}
+
+// Выбор реализации по длине паттерна
+size_t approxSearch(const char* text, size_t n, const char* pattern, size_t m,
+                    size_t k, SearchCallback cb, void* ctx) {
+    if (m <= MYERS_WORD) {
+        return myersSearch(text, n, pattern, m, k, cb, ctx);
+    }
+    return myersSearchBlocked(text, n, pattern, m, k, cb, ctx);
+}
+
+// ============ СЛОЖНОСТЬ ============
+// myersSearch: O(n) при m ≤ 64 - независимо от k
+// myersSearchBlocked: O(n·⌈m/64⌉) в худшем случае,
+//                     O(n·⌈k/64⌉) в среднем (отсечение Укконена)
+// Предобработка: O(256·⌈m/64⌉ + m)
+// Память: O(256·⌈m/64⌉) слов под Peq
+//
+// Сравнение:
+// - Прямая динамика: O(nm) - при m = 30 в ~30 раз медленнее
+// - Битовый алгоритм Ву-Манбера (Shift-And с ошибками): O(n·k·⌈m/64⌉) -
+//   на каждую допустимую ошибку своё слово состояния
+// - Майерс: время не зависит от k при m ≤ 64
+//
+// Особенности:
+// - k = 0 - точный поиск (вхождения сообщаются по концу)
+// - Одно вхождение с ошибками обычно даёт несколько соседних концов:
+//   "colour" в "color" при k = 1 оканчивается и на 'o', и на 'r'
+// - Байты сравниваются как есть: для поиска без учёта регистра
+//   приведите текст и паттерн к одному регистру заранее
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <time.h>
+#include "kmp.c"
+
+int printMatch(size_t pos, void* ctx) {
+    const char* text = (const char*)ctx;
+    size_t from = (pos >= 11) ? pos - 11 : 0;
+    printf("Вхождение оканчивается на %zu: ...%.*s\n", pos,
+           (int)(pos - from + 1), text + from);
+    return 0;
+}
+
+// Прямая динамика для проверки
+size_t dpSearch(const char* t, size_t n, const char* p, size_t m, size_t k) {
+    size_t* col = malloc(sizeof(size_t) * (m + 1));
+    for (size_t i = 0; i <= m; i++) col[i] = i;
+    size_t found = 0;
+    for (size_t j = 0; j < n; j++) {
+        size_t diag = 0;  // D[0][j-1]
+        for (size_t i = 1; i <= m; i++) {
+            size_t up = col[i];
+            size_t best = diag + (p[i - 1] != t[j]);
+            if (up + 1 < best) best = up + 1;
+            if (col[i - 1] + 1 < best) best = col[i - 1] + 1;
+            diag = up;
+            col[i] = best;
+        }
+        if (col[m] <= k) found++;
+    }
+    free(col);
+    return found;
+}
+
+int main() {
+    printf("=== Нечёткий поиск (Майерс) ===\n\n");
+
+    // Тест 1: Опечатки в каталоге
+    const char* catalog = "apple iphnoe 15 pro; samsung galaxy s24; "
+                          "iphone 14; xiaomi redmi; ipone se";
+    // "iphnoe" - перестановка соседних букв = 2 замены, при k = 1 не находится
+    printf("Тест 1: \"iphone\", k = 1\n");
+    approxSearch(catalog, strlen(catalog), "iphone", 6, 1,
+                 printMatch, (void*)catalog);
+    printf("\n");
+
+    // Тест 2: k = 0 совпадает с точным поиском
+    size_t exact = 0, approx = 0;
+    KMPSearch(catalog, strlen(catalog), "galaxy", 6, Search_Count, &exact);
+    approxSearch(catalog, strlen(catalog), "galaxy", 6, 0, Search_Count, &approx);
+    printf("Тест 2: КМП %zu, Майерс k=0 %zu\n\n", exact, approx);
+
+    // Тест 3: Сверка с динамикой, в т.ч. длинный паттерн (блоки)
+    size_t n = 200000;
+    char* text = malloc(n);
+    srand(1);
+    for (size_t i = 0; i < n; i++)
+        text[i] = "acgt"[rand() % 4];
+    char pat[200];
+    memcpy(pat, text + 5000, 200);
+    pat[17] = 'x'; pat[150] = 'y';  // две замены
+    size_t sizes[] = {20, 64, 65, 200};
+    printf("Тест 3: сверка с прямой динамикой\n");
+    for (int s = 0; s < 4; s++) {
+        size_t m = sizes[s], k = m / 8;
+        size_t a = 0;
+        approxSearch(text, n, pat, m, k, Search_Count, &a);
+        printf("m=%3zu k=%2zu: Майерс %zu, динамика %zu\n",
+               m, k, a, dpSearch(text, n, pat, m, k));
+    }
+    printf("\n");
+
+    // Тест 4: Скорость
+    size_t big = 64 << 20;
+    char* corpus = malloc(big);
+    for (size_t i = 0; i < big; i++)
+        corpus[i] = 'a' + rand() % 26;
+    const char* words[] = {"wireless headphones", "a product catalogue entry "
+        "with a rather long title that spans well over sixty four characters"};
+    printf("Тест 4: скорость на %zu МБ\n", big >> 20);
+    for (int w = 0; w < 2; w++) {
+        size_t m = strlen(words[w]), count = 0;
+        clock_t t0 = clock();
+        approxSearch(corpus, big, words[w], m, 2, Search_Count, &count);
+        double sec = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        printf("m=%3zu k=2: %.2f ГБ/с\n", m, big / sec / 1e9);
+    }
+    size_t count = 0;
+    clock_t t0 = clock();
+    KMPSearch(corpus, big, words[0], strlen(words[0]), Search_Count, &count);
+    printf("КМП (точный): %.2f ГБ/с\n",
+           big / ((double)(clock() - t0) / CLOCKS_PER_SEC) / 1e9);
+
+    free(text);
+    free(corpus);
+    return 0;
+}
+*/
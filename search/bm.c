@@ -1,37 +1,171 @@
 // Алгоритм Бойера-Мура (Boyer-Moore)
 // Поиск подстроки со сравнением справа налево
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНЫЕ ФУНКЦИИ:
+//   size_t boyerMooreSearch(text, n, pattern, m, cb, ctx)
+//       - полный Бойер-Мур (BM_FULL)
+//   size_t boyerMooreSearchVariant(text, n, pattern, m, variant, cb, ctx)
+//       - выбор варианта алгоритма:
+//
+// ВАРИАНТЫ (BMVariant):
+//   BM_BAD_CHAR - только правило плохого символа (классическая учебная
+//                 версия); O(n·m) на повторяющихся паттернах
+//   BM_FULL     - плохой символ + сильное правило хорошего суффикса
+//                 + правило Галила → O(n) в худшем случае
+//   BM_HORSPOOL - Хорспул: сдвиг по символу текста под последним
+//                 символом паттерна; одна таблица, очень простой цикл
+//   BM_SUNDAY   - Санди (Quick Search): сдвиг по символу СРАЗУ ЗА окном,
+//                 сдвиг до m+1
+//
+// Все таблицы индексируются unsigned char: байты ≥ 0x80 (UTF-8,
+// бинарные данные) обрабатываются корректно
+//
+// ==========================================
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include "search.h"
 
 #define NO_OF_CHARS 256
 
+typedef enum {
+    BM_BAD_CHAR,
+    BM_FULL,
+    BM_HORSPOOL,
+    BM_SUNDAY
+} BMVariant;
+
 // Функция для заполнения таблицы плохих символов (bad character heuristic)
-void badCharHeuristic(char* pattern, int size, int badchar[NO_OF_CHARS]) {
+void badCharHeuristic(const char* pattern, int size, int badchar[NO_OF_CHARS]) {
     // Инициализируем все значения как -1
     for (int i = 0; i < NO_OF_CHARS; i++) {
         badchar[i] = -1;
     }
     
     // Заполняем фактические позиции символов в паттерне
+    // (char может быть знаковым - индексируем через unsigned char)
     for (int i = 0; i < size; i++) {
-        badchar[(int)pattern[i]] = i;
+        badchar[(unsigned char)pattern[i]] = i;
     }
 }
 
-// Поиск всех вхождений pattern в text
-void boyerMooreSearch(char* text, char* pattern) {
-    int m = strlen(pattern);
-    int n = strlen(text);
+// Таблица хорошего суффикса (strong good suffix rule)
+// goodSuffix[j] - сдвиг, если несовпадение на позиции j,
+// а суффикс pattern[j+1..m) уже совпал:
+//   1. Ищем самое правое другое вхождение этого суффикса в паттерне,
+//      перед которым стоит ДРУГОЙ символ (сильное правило)
+//   2. Иначе - наибольший префикс паттерна, являющийся суффиксом совпавшей части
+void goodSuffixHeuristic(const char* pattern, size_t m, size_t* goodSuffix) {
+    // suff[i] - длина наибольшего общего суффикса pattern[0..i] и pattern
+    size_t* suff = malloc(sizeof(size_t) * m);
+    
+    suff[m - 1] = m;
+    long g = (long)m - 1;
+    long f = (long)m - 1;
+    for (long i = (long)m - 2; i >= 0; i--) {
+        if (i > g && (long)suff[i + m - 1 - f] < i - g) {
+            suff[i] = suff[i + m - 1 - f];
+        } else {
+            if (i < g) {
+                g = i;
+            }
+            f = i;
+            while (g >= 0 && pattern[g] == pattern[g + m - 1 - f]) {
+                g--;
+            }
+            suff[i] = (size_t)(f - g);
+        }
+    }
+    
+    // Случай 2: совпавший суффикс длиннее префикса-суффикса паттерна
+    for (size_t i = 0; i < m; i++) {
+        goodSuffix[i] = m;
+    }
+    size_t j = 0;
+    for (long i = (long)m - 1; i >= 0; i--) {
+        if (suff[i] == (size_t)i + 1) {
+            for (; j < m - 1 - (size_t)i; j++) {
+                if (goodSuffix[j] == m) {
+                    goodSuffix[j] = m - 1 - (size_t)i;
+                }
+            }
+        }
+    }
+    
+    // Случай 1: суффикс встречается внутри паттерна
+    for (size_t i = 0; i + 1 < m; i++) {
+        goodSuffix[m - 1 - suff[i]] = m - 1 - i;
+    }
     
+    free(suff);
+}
+
+// Полный Бойер-Мур: максимум из двух правил + правило Галила
+static size_t bmFull(const unsigned char* text, size_t n,
+                     const unsigned char* pattern, size_t m,
+                     SearchCallback cb, void* ctx) {
+    int badchar[NO_OF_CHARS];
+    size_t* goodSuffix = malloc(sizeof(size_t) * m);
+    badCharHeuristic((const char*)pattern, (int)m, badchar);
+    goodSuffixHeuristic((const char*)pattern, m, goodSuffix);
+    
+    // Период паттерна: сдвиг после полного совпадения
+    size_t period = goodSuffix[0];
+    
+    size_t found = 0;
+    size_t s = 0;       // сдвиг паттерна относительно текста
+    size_t known = 0;   // правило Галила: pattern[0..known) заведомо совпадает
+    
+    while (s <= n - m) {
+        long j = (long)m - 1;
+        
+        // Сравниваем справа налево, но не заходим в уже известную часть
+        while (j >= (long)known && pattern[j] == text[s + j]) {
+            j--;
+        }
+        
+        if (j < (long)known) {
+            found++;
+            if (cb(s, ctx)) {
+                break;
+            }
+            // После сдвига на период первые m - period символов окна
+            // совпадают с паттерном - повторно их не сравниваем
+            s += period;
+            known = m - period;
+        } else {
+            // Сдвиг - максимум из правил плохого символа и хорошего суффикса
+            long bc = j - badchar[text[s + j]];
+            size_t shift = goodSuffix[j];
+            if (bc > (long)shift) {
+                shift = (size_t)bc;
+            }
+            s += shift;
+            known = 0;
+        }
+    }
+    
+    free(goodSuffix);
+    return found;
+}
+
+// Только правило плохого символа (исходный учебный вариант)
+static size_t bmBadChar(const unsigned char* text, size_t n,
+                        const unsigned char* pattern, size_t m,
+                        SearchCallback cb, void* ctx) {
     int badchar[NO_OF_CHARS];
     
     // Заполняем таблицу плохих символов
-    badCharHeuristic(pattern, m, badchar);
+    badCharHeuristic((const char*)pattern, (int)m, badchar);
     
-    int s = 0;  // s - сдвиг паттерна относительно текста
+    size_t found = 0;
+    size_t s = 0;  // s - сдвиг паттерна относительно текста
     
-    while (s <= (n - m)) {
-        int j = m - 1;
+    while (s <= n - m) {
+        long j = (long)m - 1;
         
         // Сравниваем справа налево
         while (j >= 0 && pattern[j] == text[s + j]) {
@@ -40,30 +174,145 @@ void boyerMooreSearch(char* text, char* pattern) {
         
         // Если паттерн найден
         if (j < 0) {
-            printf("Найдено на позиции %d\n", s);
+            found++;
+            if (cb(s, ctx)) {
+                break;
+            }
             
             // Сдвигаемся, используя таблицу плохих символов
             s += (s + m < n) ? m - badchar[text[s + m]] : 1;
         } else {
             // Сдвигаем паттерн так, чтобы плохой символ в тексте
             // совпал с последним его вхождением в паттерн
-            int shift = j - badchar[text[s + j]];
-            s += (shift > 1) ? shift : 1;
+            long shift = j - badchar[text[s + j]];
+            s += (shift > 1) ? (size_t)shift : 1;
+        }
+    }
+    
+    return found;
+}
+
+// Хорспул: сдвиг по символу text[s + m - 1]
+// shift[c] = расстояние от последнего вхождения c в pattern[0..m-2] до конца
+static size_t bmHorspool(const unsigned char* text, size_t n,
+                         const unsigned char* pattern, size_t m,
+                         SearchCallback cb, void* ctx) {
+    size_t shift[NO_OF_CHARS];
+    for (int c = 0; c < NO_OF_CHARS; c++) {
+        shift[c] = m;
+    }
+    for (size_t i = 0; i + 1 < m; i++) {
+        shift[pattern[i]] = m - 1 - i;
+    }
+    
+    unsigned char last = pattern[m - 1];
+    size_t found = 0;
+    size_t s = 0;
+    
+    while (s <= n - m) {
+        unsigned char c = text[s + m - 1];
+        // Сначала последний символ, остальное - memcmp
+        if (c == last && memcmp(text + s, pattern, m - 1) == 0) {
+            found++;
+            if (cb(s, ctx)) {
+                break;
+            }
+        }
+        s += shift[c];
+    }
+    
+    return found;
+}
+
+// Санди: сдвиг по символу text[s + m], стоящему сразу за окном
+// shift[c] = m - (последняя позиция c в паттерне), для отсутствующих - m + 1
+static size_t bmSunday(const unsigned char* text, size_t n,
+                       const unsigned char* pattern, size_t m,
+                       SearchCallback cb, void* ctx) {
+    size_t shift[NO_OF_CHARS];
+    for (int c = 0; c < NO_OF_CHARS; c++) {
+        shift[c] = m + 1;
+    }
+    for (size_t i = 0; i < m; i++) {
+        shift[pattern[i]] = m - i;
+    }
+    
+    size_t found = 0;
+    size_t s = 0;
+    
+    while (s <= n - m) {
+        if (memcmp(text + s, pattern, m) == 0) {
+            found++;
+            if (cb(s, ctx)) {
+                break;
+            }
+        }
+        if (s + m >= n) {
+            break;  // за окном текста больше нет
         }
+        s += shift[text[s + m]];
     }
+    
+    return found;
+}
+
+// Поиск всех вхождений pattern (длины m) в text (длины n) выбранным вариантом
+// Каждое совпадение передаётся в cb; ненулевой ответ cb останавливает поиск
+// Возвращает количество найденных (переданных в cb) совпадений
+size_t boyerMooreSearchVariant(const char* text, size_t n,
+                               const char* pattern, size_t m,
+                               BMVariant variant, SearchCallback cb, void* ctx) {
+    if (m == 0 || m > n) {
+        return 0;
+    }
+    
+    const unsigned char* t = (const unsigned char*)text;
+    const unsigned char* p = (const unsigned char*)pattern;
+    
+    switch (variant) {
+        case BM_BAD_CHAR: return bmBadChar(t, n, p, m, cb, ctx);
+        case BM_HORSPOOL: return bmHorspool(t, n, p, m, cb, ctx);
+        case BM_SUNDAY:   return bmSunday(t, n, p, m, cb, ctx);
+        case BM_FULL:
+        default:          return bmFull(t, n, p, m, cb, ctx);
+    }
+}
+
+// Поиск всех вхождений pattern в text - полный Бойер-Мур
+size_t boyerMooreSearch(const char* text, size_t n, const char* pattern, size_t m,
+                        SearchCallback cb, void* ctx) {
+    return boyerMooreSearchVariant(text, n, pattern, m, BM_FULL, cb, ctx);
 }
 
 // ============ СЛОЖНОСТЬ ============
-// Построение таблицы: O(m + σ) где m - длина образца, σ - размер алфавита
+// Построение таблиц: O(m + σ) где m - длина образца, σ - размер алфавита
 // Лучший случай: O(n/m) - очень быстро!
-// Худший случай: O(n*m)
+// Худший случай:
+//   BM_FULL:                 O(n + m) - благодаря правилу Галила
+//   BM_BAD_CHAR/HORSPOOL/SUNDAY: O(n*m) (например, "aaa...a" в "aaa...a")
 // Средний случай: O(n) - субхлинейное время
-// Память: O(σ) - таблица сдвигов для алфавита (256 для ASCII)
+// Память: O(σ + m) - таблица плохих символов + таблица хорошего суффикса
 // BM - один из самых быстрых алгоритмов на практике!
+//
+// Какой вариант выбрать:
+// - Английский текст, большой алфавит: Хорспул/Санди - самый простой цикл,
+//   сдвиги почти всегда ~m
+// - ДНК (алфавит из 4 букв): плохой символ почти не помогает, хороший
+//   суффикс даёт основной сдвиг → BM_FULL
+// - Повторяющиеся данные, гарантии по времени: BM_FULL (правило Галила)
 
 // ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
 
 /*
+#include <time.h>
+
+// Обработчик: печатает позицию и продолжает поиск
+int printMatch(size_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %zu\n", pos);
+    return 0;
+}
+
 int main() {
     printf("=== Алгоритм Бойера-Мура ===\n\n");
     
@@ -72,7 +321,7 @@ int main() {
     char pattern1[] = "ABCD";
     
     printf("Тест 1: Ищем \"%s\" в \"%s\"\n", pattern1, text1);
-    boyerMooreSearch(text1, pattern1);
+    boyerMooreSearch(text1, strlen(text1), pattern1, strlen(pattern1), printMatch, NULL);
     printf("\n");
     
     // Тест 2: Поиск в английском тексте
@@ -80,7 +329,7 @@ int main() {
     char pattern2[] = "needle";
     
     printf("Тест 2: Ищем \"%s\" в \"%s\"\n", pattern2, text2);
-    boyerMooreSearch(text2, pattern2);
+    boyerMooreSearch(text2, strlen(text2), pattern2, strlen(pattern2), printMatch, NULL);
     printf("\n");
     
     // Тест 3: Повторяющийся паттерн
@@ -88,7 +337,7 @@ int main() {
     char pattern3[] = "AABA";
     
     printf("Тест 3: Ищем \"%s\" в \"%s\"\n", pattern3, text3);
-    boyerMooreSearch(text3, pattern3);
+    boyerMooreSearch(text3, strlen(text3), pattern3, strlen(pattern3), printMatch, NULL);
     printf("\n");
     
     // Тест 4: Паттерн не найден
@@ -96,7 +345,7 @@ int main() {
     char pattern4[] = "xyz";
     
     printf("Тест 4: Ищем \"%s\" в \"%s\"\n", pattern4, text4);
-    boyerMooreSearch(text4, pattern4);
+    boyerMooreSearch(text4, strlen(text4), pattern4, strlen(pattern4), printMatch, NULL);
     printf("(не найдено)\n\n");
     
     // Тест 5: Редкий символ (демонстрация скорости)
@@ -105,9 +354,67 @@ int main() {
     
     printf("Тест 5: Ищем \"%s\" (редкий паттерн)\n", pattern5);
     printf("В тексте: \"%s\"\n", text5);
-    boyerMooreSearch(text5, pattern5);
+    boyerMooreSearch(text5, strlen(text5), pattern5, strlen(pattern5), printMatch, NULL);
     printf("(Быстро нашли благодаря большим сдвигам!)\n");
     
+    // Тест 6: Бинарные данные с нулевыми байтами и буфер результатов
+    const char bin[] = {'a', '\0', 'b', 'x', 'a', '\0', 'b', 'a', '\0', 'b'};
+    const char binPat[] = {'a', '\0', 'b'};
+    size_t positions[2];
+    SearchBuffer buf = {positions, 2, 0};
+    
+    printf("Тест 6: Бинарный текст, первые 2 вхождения \"a\\0b\"\n");
+    boyerMooreSearch(bin, sizeof(bin), binPat, sizeof(binPat), Search_Collect, &buf);
+    for (size_t i = 0; i < buf.count; i++)
+        printf("Позиция %zu\n", positions[i]);  // 0, 4 (третье не ищем)
+    printf("\n");
+    
+    // Тест 7: Бенчмарк вариантов на разных корпусах
+    printf("Тест 7: Бенчмарк (ГБ/с), корпус 64 МБ\n");
+    size_t n = 64 << 20;
+    char* corpus = malloc(n);
+    const char* names[] = {"Английский", "ДНК", "Бинарный", "Повторы"};
+    const char* variants[] = {"BadChar", "Full", "Horspool", "Sunday"};
+    const char* words[] = {"the ", "of ", "and ", "search ", "pattern ",
+                           "string ", "algorithm ", "text ", "is ", "a "};
+    srand(1);
+    
+    for (int kind = 0; kind < 4; kind++) {
+        // Генерируем корпус
+        size_t i = 0;
+        while (i < n) {
+            if (kind == 0) {
+                const char* w = words[rand() % 10];
+                while (*w && i < n) corpus[i++] = *w++;
+            } else if (kind == 1) {
+                corpus[i++] = "ACGT"[rand() % 4];
+            } else if (kind == 2) {
+                corpus[i++] = (char)(rand() % 256);
+            } else {
+                corpus[i++] = 'a';
+            }
+        }
+        
+        // Паттерн - кусок из середины (для повторов - "baaa...a":
+        // несовпадение на самом левом символе - худший случай BadChar)
+        char pat[32];
+        size_t m = 16;
+        memcpy(pat, corpus + n / 2, m);
+        if (kind == 3) pat[0] = 'b';
+        
+        printf("%s:\n ", names[kind]);
+        for (int v = 0; v < 4; v++) {
+            size_t count = 0;
+            clock_t t0 = clock();
+            boyerMooreSearchVariant(corpus, n, pat, m, (BMVariant)v,
+                                    Search_Count, &count);
+            double sec = (double)(clock() - t0) / CLOCKS_PER_SEC;
+            printf("  %s %.2f", variants[v], n / sec / 1e9);
+        }
+        printf("\n");
+    }
+    free(corpus);
+    
     return 0;
 }
 */
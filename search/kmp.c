@@ -1,13 +1,17 @@
 // Алгоритм Кнута-Морриса-Пратта (KMP)
 // Поиск подстроки с использованием префикс-функции
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
+#include "search.h"
 
 // Построение префикс-функции (таблицы сдвигов)
-void computeLPSArray(char* pattern, int M, int* lps) {
-    int j = 0;  // Длина предыдущего наибольшего префикса-суффикса
+void computeLPSArray(const char* pattern, size_t M, size_t* lps) {
+    size_t j = 0;  // Длина предыдущего наибольшего префикса-суффикса
     lps[0] = 0;   // lps[0] всегда 0
-    int i = 1;
+    size_t i = 1;
     
     while (i < M) {
         if (pattern[i] == pattern[j]) {
@@ -25,19 +29,29 @@ void computeLPSArray(char* pattern, int M, int* lps) {
     }
 }
 
-// Поиск всех вхождений pattern в text
-void KMPSearch(char* text, char* pattern) {
-    int M = strlen(pattern);
-    int N = strlen(text);
+// Поиск всех вхождений pattern (длины M) в text (длины N)
+// Каждое совпадение передаётся в cb; ненулевой ответ cb останавливает поиск
+// Возвращает количество найденных (переданных в cb) совпадений
+size_t KMPSearch(const char* text, size_t N, const char* pattern, size_t M,
+                 SearchCallback cb, void* ctx) {
+    if (M == 0 || M > N) {
+        return 0;
+    }
     
     // Создаем массив lps[] (longest proper prefix which is also suffix)
-    int lps[M];
+    // В куче, а не на стеке: паттерн может быть длинным
+    // Не хватило памяти - 0 совпадений, cb не вызывается
+    size_t* lps = malloc(sizeof(size_t) * M);
+    if (!lps) {
+        return 0;
+    }
     
     // Строим префикс-функцию
     computeLPSArray(pattern, M, lps);
     
-    int i = 0;  // Индекс для text[]
-    int j = 0;  // Индекс для pattern[]
+    size_t found = 0;
+    size_t i = 0;  // Индекс для text[]
+    size_t j = 0;  // Индекс для pattern[]
     
     while (i < N) {
         if (pattern[j] == text[i]) {
@@ -46,7 +60,10 @@ void KMPSearch(char* text, char* pattern) {
         }
         
         if (j == M) {
-            printf("Найдено на позиции %d\n", i - j);
+            found++;
+            if (cb(i - j, ctx)) {
+                break;
+            }
             j = lps[j - 1];
         } else if (i < N && pattern[j] != text[i]) {
             // Несовпадение после j совпадений
@@ -57,6 +74,244 @@ void KMPSearch(char* text, char* pattern) {
             }
         }
     }
+    
+    free(lps);
+    return found;
+}
+
+// ============ ПОТОКОВЫЙ КМП ============
+//
+// Всё состояние поиска КМП - одно число j (сколько символов паттерна
+// уже совпало). Сохраняя j между вызовами, можно подавать текст кусками:
+// сеть, каналы, файлы, которые не помещаются в память и не перечитываются.
+// Совпадение, разорванное границей кусков, не теряется.
+//
+//   kmp_matcher mt;
+//   kmp_matcher_init(&mt, "needle", 6);      // lps строится один раз
+//   while (есть данные)
+//       kmp_feed(&mt, chunk, len, cb, ctx);  // позиции - от начала потока
+//   kmp_matcher_destroy(&mt);
+
+// Обработчик совпадения в потоке: pos - позиция от начала потока (64 бита)
+// Ненулевой результат останавливает обработку текущего куска
+typedef int (*KMPStreamCallback)(uint64_t pos, void* ctx);
+
+typedef struct {
+    char* pattern;      // копия паттерна (поток живёт дольше аргументов)
+    size_t m;
+    size_t* lps;        // префикс-функция
+    size_t j;           // сколько символов паттерна совпало к концу потока
+    uint64_t offset;    // сколько байт потока уже обработано
+} kmp_matcher;
+
+// Построить автомат для паттерна длины m
+// false - пустой паттерн или не хватило памяти (mt->pattern и mt->lps
+// тогда NULL - kmp_matcher_destroy безопасен)
+bool kmp_matcher_init(kmp_matcher* mt, const char* pattern, size_t m) {
+    mt->pattern = NULL;
+    mt->lps = NULL;
+    if (m == 0) {
+        return false;
+    }
+    mt->pattern = malloc(m);
+    mt->lps = malloc(sizeof(size_t) * m);
+    if (!mt->pattern || !mt->lps) {
+        free(mt->pattern);
+        free(mt->lps);
+        mt->pattern = NULL;
+        mt->lps = NULL;
+        return false;
+    }
+    memcpy(mt->pattern, pattern, m);
+    mt->m = m;
+    computeLPSArray(pattern, m, mt->lps);
+    mt->j = 0;
+    mt->offset = 0;
+    return true;
+}
+
+// Начать новый поток с тем же паттерном
+void kmp_matcher_reset(kmp_matcher* mt) {
+    mt->j = 0;
+    mt->offset = 0;
+}
+
+// Обработать очередной кусок потока
+// Возвращает 1, если cb попросил остановиться (остаток куска не обработан,
+// следующий kmp_feed продолжит с того же места потока), иначе 0
+int kmp_feed(kmp_matcher* mt, const char* chunk, size_t len,
+             KMPStreamCallback cb, void* ctx) {
+    const char* pattern = mt->pattern;
+    const size_t* lps = mt->lps;
+    size_t m = mt->m;
+    size_t j = mt->j;
+    
+    for (size_t i = 0; i < len; i++) {
+        char c = chunk[i];
+        
+        // Несовпадение - откатываемся по префикс-функции
+        while (j > 0 && pattern[j] != c) {
+            j = lps[j - 1];
+        }
+        if (pattern[j] == c) {
+            j++;
+        }
+        
+        if (j == m) {
+            j = lps[j - 1];
+            if (cb(mt->offset + i + 1 - m, ctx)) {
+                mt->j = j;
+                mt->offset += i + 1;
+                return 1;
+            }
+        }
+    }
+    
+    mt->j = j;
+    mt->offset += len;
+    return 0;
+}
+
+void kmp_matcher_destroy(kmp_matcher* mt) {
+    free(mt->pattern);
+    free(mt->lps);
+    mt->pattern = NULL;
+    mt->lps = NULL;
+}
+
+// ============ КМП КАК КОНЕЧНЫЙ АВТОМАТ (ДКА) ============
+//
+// В KMPSearch при несовпадении цикл откатывается по lps[j-1] несколько раз -
+// число итераций заранее неизвестно, переходы плохо предсказываются.
+// Если заранее посчитать, куда ведёт КАЖДЫЙ символ из КАЖДОГО состояния,
+// поиск превращается в один табличный переход на байт:
+//
+//   state = table[state + cls[byte]];   if (state == accept) → совпадение
+//
+// Таблица:
+//   dfa[j][c] = j + 1,             если j < m и pattern[j] == c
+//             = 0,                 если j == 0
+//             = dfa[lps[j-1]][c],  иначе (строка уже посчитана - lps[j-1] < j)
+//
+// Сжатие алфавита: байты, которых нет в паттерне, ведут себя одинаково -
+// объединяем их в класс 0. Для паттерна из k различных байт таблица
+// (m + 1) × (k + 1) вместо (m + 1) × 256
+//
+// Состояния хранятся уже умноженными на число классов: строка таблицы
+// находится сложением, без умножения на каждом байте
+
+typedef struct {
+    uint32_t* table;        // переходы: table[state + cls[c]], state = j * nclasses
+    unsigned char cls[256]; // класс каждого байта
+    int nclasses;           // 256 без сжатия
+    size_t m;
+    uint32_t accept;        // m * nclasses - состояние "паттерн найден"
+} kmp_dfa;
+
+// Скомпилировать паттерн в ДКА
+// compress = true - таблица по классам эквивалентности, false - полная m × 256
+// false - пустой паттерн, не хватило памяти или таблица (m + 1) × k
+// не адресуется 32-битными состояниями (паттерн в миллионы байт)
+bool kmp_dfa_compile(kmp_dfa* dfa, const char* pattern, size_t m, bool compress) {
+    dfa->table = NULL;
+    if (m == 0) {
+        return false;
+    }
+    
+    const unsigned char* p = (const unsigned char*)pattern;
+    
+    // Классы: каждый байт паттерна - свой класс, остальные - класс 0
+    if (compress) {
+        memset(dfa->cls, 0, sizeof(dfa->cls));
+        dfa->nclasses = 1;
+        for (size_t i = 0; i < m; i++) {
+            if (dfa->cls[p[i]] == 0) {
+                dfa->cls[p[i]] = (unsigned char)dfa->nclasses++;
+            }
+        }
+        // Все 256 байт в паттерне - класс 0 не нужен
+        if (dfa->nclasses > 256) {
+            compress = false;
+        }
+    }
+    if (!compress) {
+        for (int c = 0; c < 256; c++) {
+            dfa->cls[c] = (unsigned char)c;
+        }
+        dfa->nclasses = 256;
+    }
+    
+    // Размер считаем в size_t и проверяем до умножения: состояние -
+    // uint32_t, и самый большой индекс (m + 1)·k - 1 должен в него влезть
+    size_t k = (size_t)dfa->nclasses;
+    if (m >= UINT32_MAX / k || (m + 1) * k > SIZE_MAX / sizeof(uint32_t)) {
+        return false;
+    }
+    dfa->m = m;
+    dfa->accept = (uint32_t)(m * k);
+    dfa->table = malloc(sizeof(uint32_t) * (m + 1) * k);
+    size_t* lps = malloc(sizeof(size_t) * m);
+    if (!dfa->table || !lps) {
+        free(dfa->table);
+        free(lps);
+        dfa->table = NULL;
+        return false;
+    }
+    computeLPSArray(pattern, m, lps);
+    
+    for (size_t j = 0; j <= m; j++) {
+        uint32_t* row = &dfa->table[j * k];
+        
+        // Несовпадение: из состояния 0 - в 0, иначе - как из lps[j-1]
+        if (j == 0) {
+            for (size_t c = 0; c < k; c++) {
+                row[c] = 0;
+            }
+        } else {
+            const uint32_t* fallback = &dfa->table[lps[j - 1] * k];
+            memcpy(row, fallback, sizeof(uint32_t) * k);
+        }
+        
+        // Совпадение: следующий символ паттерна ведёт в j + 1
+        if (j < m) {
+            row[dfa->cls[p[j]]] = (uint32_t)((j + 1) * k);
+        }
+    }
+    
+    free(lps);
+    return true;
+}
+
+// Поиск всех вхождений скомпилированного паттерна в text (длины n)
+// Каждое совпадение передаётся в cb; ненулевой ответ cb останавливает поиск
+// Возвращает количество найденных (переданных в cb) совпадений
+size_t kmp_dfa_search(const kmp_dfa* dfa, const char* text, size_t n,
+                      SearchCallback cb, void* ctx) {
+    const unsigned char* t = (const unsigned char*)text;
+    const uint32_t* table = dfa->table;
+    const unsigned char* cls = dfa->cls;
+    const uint32_t accept = dfa->accept;
+    uint32_t state = 0;
+    size_t found = 0;
+    
+    for (size_t i = 0; i < n; i++) {
+        // Один переход на байт - без цикла откатов
+        state = table[state + cls[t[i]]];
+        
+        if (state == accept) {
+            found++;
+            if (cb(i + 1 - dfa->m, ctx)) {
+                break;
+            }
+        }
+    }
+    
+    return found;
+}
+
+void kmp_dfa_destroy(kmp_dfa* dfa) {
+    free(dfa->table);
+    dfa->table = NULL;
 }
 
 // ============ СЛОЖНОСТЬ ============
@@ -65,10 +320,32 @@ void KMPSearch(char* text, char* pattern) {
 // Общая сложность: O(n + m)
 // Память: O(m) - таблица сдвигов
 // КМП не возвращается назад в тексте - линейное время!
+// Длины передаются явно: нет strlen на каждом вызове, нулевые байты
+// в тексте и паттерне допустимы (бинарные данные)
+// kmp_feed: O(len) на кусок (амортизированно), O(m) памяти на поток
+// kmp_dfa: построение O(m·σ'), поиск - ровно n переходов, O(m·σ') памяти
+//          (σ' - число классов, ≤ 256); выгоден, когда паттерн
+//          компилируется один раз, а текста - гигабайты
 
 // ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
 
 /*
+#include <time.h>
+
+// Обработчик: печатает позицию и продолжает поиск
+int printMatch(size_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %zu\n", pos);
+    return 0;
+}
+
+// Обработчик для потока: позиция - от начала потока
+int printStreamMatch(uint64_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %llu\n", (unsigned long long)pos);
+    return 0;
+}
+
 int main() {
     printf("=== Алгоритм Кнута-Морриса-Пратта (KMP) ===\n\n");
     
@@ -77,7 +354,7 @@ int main() {
     char pattern1[] = "ABABC";
     
     printf("Тест 1: Ищем \"%s\" в \"%s\"\n", pattern1, text1);
-    KMPSearch(text1, pattern1);
+    KMPSearch(text1, strlen(text1), pattern1, strlen(pattern1), printMatch, NULL);
     printf("\n");
     
     // Тест 2: Множественные вхождения
@@ -85,7 +362,7 @@ int main() {
     char pattern2[] = "AABA";
     
     printf("Тест 2: Ищем \"%s\" в \"%s\"\n", pattern2, text2);
-    KMPSearch(text2, pattern2);
+    KMPSearch(text2, strlen(text2), pattern2, strlen(pattern2), printMatch, NULL);
     printf("\n");
     
     // Тест 3: Поиск в тексте
@@ -93,7 +370,7 @@ int main() {
     char pattern3[] = "pattern";
     
     printf("Тест 3: Ищем \"%s\" в \"%s\"\n", pattern3, text3);
-    KMPSearch(text3, pattern3);
+    KMPSearch(text3, strlen(text3), pattern3, strlen(pattern3), printMatch, NULL);
     printf("\n");
     
     // Тест 4: Паттерн не найден
@@ -101,22 +378,70 @@ int main() {
     char pattern4[] = "xyz";
     
     printf("Тест 4: Ищем \"%s\" в \"%s\"\n", pattern4, text4);
-    KMPSearch(text4, pattern4);
+    KMPSearch(text4, strlen(text4), pattern4, strlen(pattern4), printMatch, NULL);
     printf("(не найдено)\n\n");
     
     // Тест 5: Демонстрация префикс-функции
     printf("=== Префикс-функция для \"ABABC\" ===\n");
     char demo[] = "ABABC";
-    int M = strlen(demo);
-    int lps[M];
+    size_t M = strlen(demo);
+    size_t lps[M];
     computeLPSArray(demo, M, lps);
     
     printf("Паттерн: ");
-    for (int i = 0; i < M; i++) printf("%c ", demo[i]);
+    for (size_t i = 0; i < M; i++) printf("%c ", demo[i]);
     printf("\nLPS:     ");
-    for (int i = 0; i < M; i++) printf("%d ", lps[i]);
+    for (size_t i = 0; i < M; i++) printf("%zu ", lps[i]);
+    printf("\n\n");
+    
+    // Тест 6: Бинарные данные с нулевыми байтами и буфер результатов
+    const char bin[] = {'a', '\0', 'b', 'x', 'a', '\0', 'b', 'a', '\0', 'b'};
+    const char binPat[] = {'a', '\0', 'b'};
+    size_t positions[2];
+    SearchBuffer buf = {positions, 2, 0};
+    
+    printf("Тест 6: Бинарный текст, первые 2 вхождения \"a\\0b\"\n");
+    KMPSearch(bin, sizeof(bin), binPat, sizeof(binPat), Search_Collect, &buf);
+    for (size_t i = 0; i < buf.count; i++)
+        printf("Позиция %zu\n", positions[i]);  // 0, 4 (третье не ищем)
     printf("\n");
     
+    // Тест 7: Поток кусками - совпадение разорвано границей
+    printf("Тест 7: Поток \"xxAB\" + \"ABCx\" + \"ABABC\", ищем \"ABABC\"\n");
+    kmp_matcher mt;
+    kmp_matcher_init(&mt, "ABABC", 5);
+    kmp_feed(&mt, "xxAB", 4, printStreamMatch, NULL);
+    kmp_feed(&mt, "ABCx", 4, printStreamMatch, NULL);   // позиция 2
+    kmp_feed(&mt, "ABABC", 5, printStreamMatch, NULL);  // позиция 8
+    kmp_matcher_destroy(&mt);
+    printf("\n");
+    
+    // Тест 8: ДКА - компилируем один раз, ищем много раз
+    printf("Тест 8: ДКА для \"ABABC\" (сжатый и полный)\n");
+    kmp_dfa small, full;
+    kmp_dfa_compile(&small, "ABABC", 5, true);
+    kmp_dfa_compile(&full, "ABABC", 5, false);
+    printf("Классов: %d и %d\n", small.nclasses, full.nclasses);  // 4 и 256
+    kmp_dfa_search(&small, text1, strlen(text1), printMatch, NULL);  // 10
+    
+    size_t big = 64 << 20;
+    char* data = malloc(big);
+    srand(1);
+    for (size_t i = 0; i < big; i++)
+        data[i] = "ABC"[rand() % 3];  // случайные откаты - плохо для предсказателя
+    size_t c1 = 0, c2 = 0;
+    clock_t t0 = clock();
+    KMPSearch(data, big, "ABABC", 5, Search_Count, &c1);
+    clock_t t1 = clock();
+    kmp_dfa_search(&small, data, big, Search_Count, &c2);
+    clock_t t2 = clock();
+    printf("KMPSearch: %.2f с, kmp_dfa_search: %.2f с (совпадений %zu = %zu)\n",
+           (double)(t1 - t0) / CLOCKS_PER_SEC, (double)(t2 - t1) / CLOCKS_PER_SEC,
+           c1, c2);
+    free(data);
+    kmp_dfa_destroy(&small);
+    kmp_dfa_destroy(&full);
+    
     return 0;
 }
 */
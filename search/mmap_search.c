@@ -0,0 +1,200 @@
+// Поиск в файле через отображение в память (mmap)
+// Любой алгоритм из search/ работает прямо по страницам файла, без копирования
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНАЯ ФУНКЦИЯ:
+//   long long mmapSearchFile(const char* path, SearchFn engine,
+//                            const char* pattern, size_t m, size_t window,
+//                            SearchCallback cb, void* ctx)
+//   - engine: KMPSearch, boyerMooreSearch, rabinKarp, simdSearch, ...
+//   - window: размер окна отображения в байтах (0 → MMAP_DEFAULT_WINDOW)
+//   - позиции в cb - от начала ФАЙЛА
+//   - возвращает число совпадений или -1 при ошибке (errno сохраняется)
+//
+// ЗАЧЕМ:
+//   fread копирует данные из кэша страниц ядра в буфер программы -
+//   каждый байт файла проходит через память дважды. mmap отображает
+//   страницы кэша прямо в адресное пространство: алгоритм читает их
+//   без копирования
+//
+// СКОЛЬЗЯЩЕЕ ОКНО:
+//   Файл может быть больше адресного пространства (или его разумной
+//   доли), поэтому отображаем его окнами:
+//
+//      файл:  |------ окно 0 ------|------ окно 1 ------|---- окно 2 ----|
+//                             |m-1| ← окно 0 отображается с перекрытием
+//
+//   - окно k отвечает за совпадения, НАЧИНАЮЩИЕСЯ в [k·W, (k+1)·W)
+//   - отображается [k·W, (k+1)·W + m - 1) - совпадение через границу
+//     целиком попадает в окно, где оно начинается; дубликатов нет
+//   - W кратно размеру страницы: смещение mmap обязано быть выровнено
+//   - madvise(MADV_SEQUENTIAL): ядро читает наперёд и быстрее
+//     освобождает пройденные страницы
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "search.h"
+
+// Окно по умолчанию - 1 ГБ: мало системных вызовов, умеренный расход
+// адресного пространства
+#define MMAP_DEFAULT_WINDOW ((size_t)1 << 30)
+
+// Перевод позиций из окна в позиции файла
+typedef struct {
+    SearchCallback cb;
+    void* ctx;
+    size_t base;        // смещение окна в файле
+    int stopped;
+} MmapWindow;
+
+static int mmapWindowCallback(size_t pos, void* ctx) {
+    MmapWindow* w = (MmapWindow*)ctx;
+    if (w->cb(w->base + pos, w->ctx)) {
+        w->stopped = 1;
+        return 1;
+    }
+    return 0;
+}
+
+// Поиск всех вхождений pattern (длины m) в файле path
+// Каждое совпадение передаётся в cb (позиция от начала файла);
+// ненулевой ответ cb останавливает поиск
+// Возвращает количество переданных в cb совпадений или -1 при ошибке
+long long mmapSearchFile(const char* path, SearchFn engine,
+                         const char* pattern, size_t m, size_t window,
+                         SearchCallback cb, void* ctx) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+
+    size_t size = (size_t)st.st_size;
+    if (m == 0 || m > size) {
+        close(fd);
+        return 0;
+    }
+
+    // Окно кратно странице и не меньше одной страницы
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    if (window == 0) {
+        window = MMAP_DEFAULT_WINDOW;
+    }
+    window = (window + page - 1) / page * page;
+
+    long long found = 0;
+    MmapWindow w = {cb, ctx, 0, 0};
+
+    // Последнее возможное начало совпадения - size - m
+    for (size_t start = 0; start <= size - m && !w.stopped; start += window) {
+        // Окно + перекрытие m - 1, но не дальше конца файла
+        size_t len = window + m - 1;
+        if (len > size - start) {
+            len = size - start;
+        }
+
+        void* map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, (off_t)start);
+        if (map == MAP_FAILED) {
+            int saved = errno;
+            close(fd);
+            errno = saved;
+            return -1;
+        }
+        madvise(map, len, MADV_SEQUENTIAL);
+
+        w.base = start;
+        found += (long long)engine((const char*)map, len, pattern, m,
+                                   mmapWindowCallback, &w);
+
+        munmap(map, len);
+    }
+
+    close(fd);
+    return found;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// Время: время алгоритма на n байт + O(n / W) системных вызовов mmap/munmap
+// Память: O(1) своей памяти; страницы файла - в кэше ядра, общем
+//         для всех процессов
+// Дополнительная работа: (m - 1) байт перекрытия на окно
+//
+// Особенности:
+// - Нет копирования: по сравнению с fread вдвое меньше трафика памяти
+// - Файлы больше адресного пространства - скользящим окном
+// - Позиции - size_t: для файлов > 4 ГБ нужна 64-битная платформа
+// - Файл не должен укорачиваться во время поиска: обращение к странице
+//   за новым концом файла даёт SIGBUS
+// - Для параллельного поиска внутри окна можно передать engine,
+//   вызывающий parallelSearch
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <time.h>
+#include "kmp.c"
+#include "simd_search.c"
+#include "bm.c"
+
+int printMatch(size_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %zu\n", pos);
+    return 0;
+}
+
+int main() {
+    printf("=== Поиск в файле через mmap ===\n\n");
+
+    // Готовим файл: совпадения на границах маленьких окон
+    const char* path = "/tmp/mmap_search_demo.txt";
+    FILE* f = fopen(path, "wb");
+    for (int i = 0; i < 4096 * 3; i++)
+        fputc('.', f);
+    fclose(f);
+
+    f = fopen(path, "r+b");
+    long at[] = {0, 4096 - 3, 8192 - 1, 4096 * 3 - 6};  // через границы страниц
+    for (int i = 0; i < 4; i++) {
+        fseek(f, at[i], SEEK_SET);
+        fwrite("needle", 1, 6, f);
+    }
+    fclose(f);
+
+    // Тест 1: Окно в одну страницу - совпадения через границу не теряются
+    printf("Тест 1: окно 4096 байт, Бойер-Мур\n");
+    long long n1 = mmapSearchFile(path, boyerMooreSearch, "needle", 6, 4096,
+                                  printMatch, NULL);
+    printf("Всего: %lld\n\n", n1);  // 0, 4093, 8191, 12282
+
+    // Тест 2: Окно по умолчанию, SIMD-поиск
+    printf("Тест 2: окно по умолчанию, simdSearch\n");
+    size_t count = 0;
+    mmapSearchFile(path, simdSearch, "needle", 6, 0, Search_Count, &count);
+    printf("Всего: %zu\n\n", count);  // 4
+
+    // Тест 3: Ошибка открытия
+    long long r = mmapSearchFile("/nonexistent", KMPSearch, "x", 1, 0,
+                                 Search_Count, &count);
+    printf("Тест 3: несуществующий файл → %lld\n", r);  // -1
+
+    remove(path);
+    return 0;
+}
+*/
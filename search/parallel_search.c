@@ -0,0 +1,256 @@
+// Параллельный поиск подстроки по кускам текста
+// Драйвер над любым алгоритмом из search/ (KMPSearch, boyerMooreSearch, ...)
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНАЯ ФУНКЦИЯ:
+//   long long parallelSearch(SearchFn engine, const char* text, size_t n,
+//                            const char* pattern, size_t m, int threads,
+//                            SearchCallback cb, void* ctx)
+//   - threads = 0 → по числу процессоров
+//   - -1 → не хватило памяти под позиции куска, cb не вызывался
+//
+// ИДЕЯ:
+//   1. Делим ПОЗИЦИИ НАЧАЛА совпадений [0, n - m] на threads отрезков
+//   2. Поток i ищет в куске текста [lo, hi + m - 1): кусок перекрывается
+//      со следующим на m - 1 байт, поэтому совпадения через границу
+//      не теряются
+//
+//      текст:  |-------- кусок 0 --------|-------- кусок 1 --------|
+//                                   |m-1|
+//              поток 0 читает до сюда ↑ (но начала совпадений < hi)
+//
+//   3. Совпадение принадлежит куску, где лежит его НАЧАЛО. Кусок i
+//      заканчивается раньше, чем могло бы начаться совпадение из куска i+1,
+//      так что одно и то же совпадение не находится дважды
+//   4. Каждый поток копит позиции в свой массив; после завершения всех
+//      потоков массивы отдаются в cb по порядку кусков → позиции
+//      возрастают, как при последовательном поиске
+//
+// ВАЖНО:
+//   - cb вызывается только из вызывающего потока: его не нужно
+//     делать потокобезопасным
+//   - Ненулевой ответ cb останавливает выдачу результатов
+//   - engine вызывается из нескольких потоков сразу - его ленивая
+//     инициализация должна быть потокобезопасной (simdSearch и rabinKarp
+//     делают её под pthread_once)
+//   - Не удалось создать поток - его кусок ищется в вызывающем потоке,
+//     результаты не теряются
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "search.h"
+
+// Кусок меньше этого не делим: накладные расходы на поток
+// (создание, запуск) больше выигрыша
+#define PARALLEL_MIN_CHUNK (1 << 20)
+
+// Задание одного потока и его результаты
+typedef struct {
+    SearchFn engine;
+    const char* text;
+    const char* pattern;
+    size_t m;
+    size_t lo;          // первая позиция начала совпадения куска
+    size_t hi;          // позиция за последней
+    size_t* pos;        // найденные позиции (глобальные)
+    size_t count;
+    size_t capacity;
+    bool failed;        // не хватило памяти - результаты куска неполны
+} SearchChunk;
+
+// Обработчик внутри потока: сохранить позицию в массив куска
+static int chunkCollect(size_t pos, void* ctx) {
+    SearchChunk* c = (SearchChunk*)ctx;
+    if (c->count == c->capacity) {
+        size_t capacity = c->capacity ? c->capacity * 2 : 64;
+        size_t* pos = realloc(c->pos, sizeof(size_t) * capacity);
+        if (!pos) {
+            // c->pos цел и освободится при слиянии; engine остановится
+            c->failed = true;
+            return 1;
+        }
+        c->pos = pos;
+        c->capacity = capacity;
+    }
+    c->pos[c->count++] = c->lo + pos;
+    return 0;
+}
+
+static void* chunkWorker(void* arg) {
+    SearchChunk* c = (SearchChunk*)arg;
+    // Кусок текста: начала [lo, hi) плюс m - 1 байт перекрытия
+    size_t len = c->hi - c->lo + c->m - 1;
+    c->engine(c->text + c->lo, len, c->pattern, c->m, chunkCollect, c);
+    return NULL;
+}
+
+// Поиск всех вхождений pattern (длины m) в text (длины n) в threads потоков
+// Каждое совпадение передаётся в cb по возрастанию позиций;
+// ненулевой ответ cb останавливает выдачу
+// Возвращает количество переданных в cb совпадений или -1, если кусок
+// не смог сохранить свои позиции (тогда cb не вызывается вовсе)
+long long parallelSearch(SearchFn engine, const char* text, size_t n,
+                         const char* pattern, size_t m, int threads,
+                         SearchCallback cb, void* ctx) {
+    if (m == 0 || m > n) {
+        return 0;
+    }
+
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (int)cpus : 1;
+    }
+
+    // Количество позиций начала совпадения
+    size_t starts = n - m + 1;
+
+    // Мелкий текст - нет смысла запускать потоки
+    size_t maxChunks = starts / PARALLEL_MIN_CHUNK;
+    if (maxChunks < (size_t)threads) {
+        threads = (maxChunks > 0) ? (int)maxChunks : 1;
+    }
+    if (threads == 1) {
+        return (long long)engine(text, n, pattern, m, cb, ctx);
+    }
+
+    SearchChunk* chunks = calloc((size_t)threads, sizeof(SearchChunk));
+    pthread_t* tids = malloc(sizeof(pthread_t) * (size_t)threads);
+    // pthread_t непрозрачен: "поток не создан" храним отдельно
+    bool* started = calloc((size_t)threads, sizeof(bool));
+    if (!chunks || !tids || !started) {
+        free(chunks);
+        free(tids);
+        free(started);
+        return (long long)engine(text, n, pattern, m, cb, ctx);
+    }
+
+    // Делим позиции начала поровну
+    size_t step = starts / (size_t)threads;
+    for (int i = 0; i < threads; i++) {
+        chunks[i].engine = engine;
+        chunks[i].text = text;
+        chunks[i].pattern = pattern;
+        chunks[i].m = m;
+        chunks[i].lo = (size_t)i * step;
+        chunks[i].hi = (i == threads - 1) ? starts : (size_t)(i + 1) * step;
+    }
+
+    // Кусок 0 ищем сами, остальные - в новых потоках
+    for (int i = 1; i < threads; i++) {
+        started[i] = pthread_create(&tids[i], NULL, chunkWorker, &chunks[i]) == 0;
+    }
+    chunkWorker(&chunks[0]);
+    // Куски, для которых поток не создался, - тоже сами
+    for (int i = 1; i < threads; i++) {
+        if (!started[i]) {
+            chunkWorker(&chunks[i]);
+        }
+    }
+    for (int i = 1; i < threads; i++) {
+        if (started[i]) {
+            pthread_join(tids[i], NULL);
+        }
+    }
+
+    // Кусок с неполными результатами - ошибка всего поиска,
+    // а не молча укороченный ответ
+    bool failed = false;
+    for (int i = 0; i < threads; i++) {
+        failed = failed || chunks[i].failed;
+    }
+
+    // Слияние: куски упорядочены, позиции внутри куска упорядочены
+    long long found = failed ? -1 : 0;
+    int stopped = failed;
+    for (int i = 0; i < threads; i++) {
+        for (size_t j = 0; j < chunks[i].count && !stopped; j++) {
+            found++;
+            stopped = cb(chunks[i].pos[j], ctx);
+        }
+        free(chunks[i].pos);
+    }
+
+    free(chunks);
+    free(tids);
+    free(started);
+    return found;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// Время: O(T(n/p + m)) на поток, где T - время алгоритма, p - число потоков
+//        + O(z) на слияние, z - число совпадений
+// Память: O(z) - позиции копятся до слияния
+// Дополнительная работа: (p - 1)(m - 1) байт перекрытия - ничтожно при n >> p·m
+//
+// Особенности:
+// - Куски не зависят друг от друга - ускорение почти линейное,
+//   пока не упрёмся в пропускную способность памяти
+// - На быстрых алгоритмах (simdSearch) память насыщается уже
+//   несколькими потоками; на медленных (KMPSearch) - масштабируется дальше
+// - Куски не меньше PARALLEL_MIN_CHUNK: на мелком тексте работает
+//   последовательно
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <time.h>
+#include "kmp.c"
+#include "simd_search.c"
+#include "bm.c"
+#include "rk.c"
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    printf("=== Параллельный поиск подстроки ===\n\n");
+
+    size_t n = 256 << 20;
+    char* text = malloc(n);
+    srand(1);
+    for (size_t i = 0; i < n; i++)
+        text[i] = 'a' + rand() % 4;
+
+    // Совпадения ровно на границах будущих кусков
+    const char* pat = "abcdabcd";
+    size_t m = strlen(pat);
+    for (size_t i = 1; i < 64; i++)
+        memcpy(text + i * (n / 64) - m / 2, pat, m);
+
+    // Тест 1: Результат совпадает с последовательным поиском
+    size_t seq = 0, par = 0;
+    KMPSearch(text, n, pat, m, Search_Count, &seq);
+    parallelSearch(KMPSearch, text, n, pat, m, 0, Search_Count, &par);
+    printf("Тест 1: последовательно %zu, параллельно %zu\n\n", seq, par);
+
+    // Тест 2: Масштабирование по числу потоков
+    SearchFn engines[] = {KMPSearch, boyerMooreSearch, rabinKarp, simdSearch};
+    const char* names[] = {"KMP", "BM", "RK", "SIMD"};
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    printf("Тест 2: ГБ/с по числу потоков\n");
+    for (int e = 0; e < 4; e++) {
+        printf("%-5s", names[e]);
+        for (int t = 1; t <= cpus; t *= 2) {
+            size_t count = 0;
+            double t0 = now();
+            parallelSearch(engines[e], text, n, pat, m, t, Search_Count, &count);
+            printf("  %dT: %.2f", t, n / (now() - t0) / 1e9);
+        }
+        printf("\n");
+    }
+
+    free(text);
+    return 0;
+}
+*/
@@ -1,67 +1,346 @@
 // Алгоритм Рабина-Карпа (Rabin-Karp)
 // Поиск подстроки с использованием хэш-функции
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНЫЕ ФУНКЦИИ:
+//   size_t rabinKarp(text, n, pattern, m, cb, ctx)  - один паттерн
+//   size_t RK_HashWindows(text, n, m, out)          - хэши всех окон длины m
+//                                                     (шинглы) за один проход
+//   bool   RK_SetBuild(set, patterns, m, count)     - набор паттернов длины m
+//   size_t RK_MultiSearch(set, text, n, cb, ctx)    - все паттерны за проход
+//   size_t RK_SearchBatch(set, texts, lens, count, cb, ctx)
+//                                                   - пакет документов
+//   void   RK_SetDestroy(set)
+//
+// ХЭШ-ФУНКЦИЯ:
+//   hash(s) = (s[0]·B^(m-1) + ... + s[m-1]) mod P,  P = 2^61 - 1 (простое Мерсенна)
+//   - Модуль 2^61-1 вместо маленького q = 101: вероятность коллизии
+//     ~ m / 2^61 вместо ~ 1/101 - ложные проверки практически исчезают
+//   - Взятие по модулю Мерсенна - сдвиг и сложение, без деления
+//   - Основание B выбирается случайно при первом вызове (pthread_once -
+//     одно на процесс, даже если первыми поиск начинают несколько потоков):
+//     подобрать текст с массой коллизий заранее невозможно
+//
+// НЕСКОЛЬКО ПАТТЕРНОВ ОДНОЙ ДЛИНЫ:
+//   Хэши паттернов складываются в хэш-таблицу с открытой адресацией.
+//   Хэш каждого окна текста ищется в ней за O(1) → весь набор
+//   проверяется за один проход по тексту
+//
+// ==========================================
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "search.h"
 
-#define d 256  // Размер алфавита (ASCII)
+#define RK_MOD ((1ULL << 61) - 1)  // Модуль - простое число Мерсенна 2^61 - 1
 
-// Поиск всех вхождений pattern в text
-void rabinKarp(char* text, char* pattern) {
-    int M = strlen(pattern);
-    int N = strlen(text);
-    int q = 101;  // Простое число для модуля
-    
-    int h = 1;  // h = d^(M-1) % q
-    int p = 0;  // Хэш паттерна
-    int t = 0;  // Хэш текущего окна текста
-    
-    // Вычисляем h = d^(M-1) % q
-    for (int i = 0; i < M - 1; i++) {
-        h = (h * d) % q;
+// (a · b) mod (2^61 - 1) через 128-битное произведение
+static inline uint64_t rkMul(uint64_t a, uint64_t b) {
+    unsigned __int128 p = (unsigned __int128)a * b;
+    uint64_t r = (uint64_t)(p & RK_MOD) + (uint64_t)(p >> 61);
+    return (r >= RK_MOD) ? r - RK_MOD : r;
+}
+
+static inline uint64_t rkAdd(uint64_t a, uint64_t b) {
+    uint64_t r = a + b;
+    return (r >= RK_MOD) ? r - RK_MOD : r;
+}
+
+static inline uint64_t rkSub(uint64_t a, uint64_t b) {
+    return (a >= b) ? a - b : a + RK_MOD - b;
+}
+
+static uint64_t rkBaseValue;
+static pthread_once_t rkBaseOnce = PTHREAD_ONCE_INIT;
+
+static void rkBaseInit(void) {
+    // Перемешиваем время и адрес (splitmix64)
+    uint64_t x = (uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)&rkBaseValue;
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    rkBaseValue = 256 + x % (RK_MOD - 512);  // основание больше размера алфавита
+}
+
+// Основание хэша: случайное, выбирается один раз на процесс
+// Все потоки получают одно и то же значение - хэши паттерна и окон,
+// посчитанные в разных потоках, сравнимы
+static uint64_t rkBase(void) {
+    pthread_once(&rkBaseOnce, rkBaseInit);
+    return rkBaseValue;
+}
+
+// Хэш строки длины m при основании B
+static uint64_t rkHash(const unsigned char* s, size_t m, uint64_t B) {
+    uint64_t h = 0;
+    for (size_t i = 0; i < m; i++) {
+        h = rkAdd(rkMul(h, B), s[i]);
     }
-    
-    // Вычисляем хэш паттерна и первого окна текста
-    for (int i = 0; i < M; i++) {
-        p = (d * p + pattern[i]) % q;
-        t = (d * t + text[i]) % q;
+    return h;
+}
+
+// B^(m-1) mod P - вес первого символа окна
+static uint64_t rkPower(size_t m, uint64_t B) {
+    uint64_t h = 1;
+    for (size_t i = 0; i + 1 < m; i++) {
+        h = rkMul(h, B);
+    }
+    return h;
+}
+
+// Сдвиг окна: убираем out (вес h), добавляем in
+static inline uint64_t rkRoll(uint64_t t, unsigned char out, unsigned char in,
+                              uint64_t h, uint64_t B) {
+    return rkAdd(rkMul(rkSub(t, rkMul(out, h)), B), in);
+}
+
+// Поиск всех вхождений pattern (длины M) в text (длины N)
+// Каждое совпадение передаётся в cb; ненулевой ответ cb останавливает поиск
+// Возвращает количество найденных (переданных в cb) совпадений
+size_t rabinKarp(const char* text, size_t N, const char* pattern, size_t M,
+                 SearchCallback cb, void* ctx) {
+    if (M == 0 || M > N) {
+        return 0;
     }
     
+    const unsigned char* T = (const unsigned char*)text;
+    
+    uint64_t B = rkBase();
+    uint64_t h = rkPower(M, B);                                 // h = B^(M-1) mod P
+    uint64_t p = rkHash((const unsigned char*)pattern, M, B);   // Хэш паттерна
+    uint64_t t = rkHash(T, M, B);                               // Хэш первого окна
+    size_t found = 0;
+    
     // Сдвигаем окно по тексту
-    for (int i = 0; i <= N - M; i++) {
+    for (size_t i = 0; i <= N - M; i++) {
         // Если хэши совпали - проверяем посимвольно
-        if (p == t) {
-            int j;
-            for (j = 0; j < M; j++) {
-                if (text[i + j] != pattern[j])
-                    break;
-            }
-            
-            if (j == M) {
-                printf("Найдено на позиции %d\n", i);
+        if (p == t && memcmp(text + i, pattern, M) == 0) {
+            found++;
+            if (cb(i, ctx)) {
+                break;
             }
         }
         
         // Вычисляем хэш следующего окна
         if (i < N - M) {
-            t = (d * (t - text[i] * h) + text[i + M]) % q;
-            
-            // Если получилось отрицательное - делаем положительным
-            if (t < 0) {
-                t = t + q;
+            t = rkRoll(t, T[i], T[i + M], h, B);
+        }
+    }
+    
+    return found;
+}
+
+// Хэши всех окон длины m (шинглов) за один проход
+// out должен вмещать n - m + 1 значений. Возвращает их количество
+size_t RK_HashWindows(const char* text, size_t n, size_t m, uint64_t* out) {
+    if (m == 0 || m > n) {
+        return 0;
+    }
+    
+    const unsigned char* T = (const unsigned char*)text;
+    uint64_t B = rkBase();
+    uint64_t h = rkPower(m, B);
+    uint64_t t = rkHash(T, m, B);
+    
+    out[0] = t;
+    for (size_t i = 1; i <= n - m; i++) {
+        t = rkRoll(t, T[i - 1], T[i + m - 1], h, B);
+        out[i] = t;
+    }
+    return n - m + 1;
+}
+
+// ============ НЕСКОЛЬКО ПАТТЕРНОВ ============
+
+// Обработчик совпадения в мультипоиске: pattern - номер паттерна,
+// pos - позиция в тексте. Ненулевой результат останавливает поиск
+typedef int (*RK_MultiCallback)(int pattern, size_t pos, void* ctx);
+
+// Обработчик для пакета документов: text - номер документа
+typedef int (*RK_BatchCallback)(int text, int pattern, size_t pos, void* ctx);
+
+// Набор паттернов одной длины
+// Строки паттернов не копируются - они должны жить, пока жив набор
+typedef struct {
+    uint64_t* hashes;          // хэш-таблица: хэши паттернов
+    int* ids;                  // номера паттернов (-1 - пустая ячейка)
+    size_t mask;               // размер таблицы - 1 (размер - степень двойки)
+    const char* const* patterns;
+    size_t m;                  // общая длина паттернов
+    int count;
+} RKSet;
+
+// Начальная ячейка для хэша (старшие биты лучше перемешаны)
+static inline size_t rkSlot(uint64_t hash, size_t mask) {
+    return (size_t)((hash * 0x9E3779B97F4A7C15ULL) >> 20) & mask;
+}
+
+// Построить набор из count паттернов длины m
+// false - пустой набор, m == 0 или не хватило памяти
+bool RK_SetBuild(RKSet* set, const char* const* patterns, size_t m, int count) {
+    memset(set, 0, sizeof(*set));
+    if (m == 0 || count <= 0) {
+        return false;
+    }
+    
+    // Заполненность таблицы не больше 1/2 - короткие цепочки проб
+    size_t capacity = 16;
+    while (capacity < 2 * (size_t)count) {
+        capacity *= 2;
+    }
+    
+    set->hashes = malloc(sizeof(uint64_t) * capacity);
+    set->ids = malloc(sizeof(int) * capacity);
+    if (!set->hashes || !set->ids) {
+        free(set->hashes);
+        free(set->ids);
+        memset(set, 0, sizeof(*set));  // RK_SetDestroy для него безопасен
+        return false;
+    }
+    set->mask = capacity - 1;
+    set->patterns = patterns;
+    set->m = m;
+    set->count = count;
+    for (size_t i = 0; i < capacity; i++) {
+        set->ids[i] = -1;
+    }
+    
+    // Линейное пробирование: занятая ячейка → следующая
+    uint64_t B = rkBase();
+    for (int p = 0; p < count; p++) {
+        uint64_t hash = rkHash((const unsigned char*)patterns[p], m, B);
+        size_t slot = rkSlot(hash, set->mask);
+        while (set->ids[slot] >= 0) {
+            slot = (slot + 1) & set->mask;
+        }
+        set->hashes[slot] = hash;
+        set->ids[slot] = p;
+    }
+    return true;
+}
+
+void RK_SetDestroy(RKSet* set) {
+    free(set->hashes);
+    free(set->ids);
+    memset(set, 0, sizeof(*set));
+}
+
+// Проверить окно text[pos..pos+m) с хэшем t по всему набору
+// Возвращает 1, если обработчик попросил остановиться
+static int rkSetProbe(const RKSet* set, const char* text, size_t pos, uint64_t t,
+                      int textId, RK_MultiCallback mcb, RK_BatchCallback bcb,
+                      void* ctx, size_t* found) {
+    size_t slot = rkSlot(t, set->mask);
+    // Идём до пустой ячейки: там могут быть несколько паттернов
+    // с тем же хэшем (одинаковые паттерны или коллизия)
+    while (set->ids[slot] >= 0) {
+        if (set->hashes[slot] == t) {
+            int p = set->ids[slot];
+            if (memcmp(text + pos, set->patterns[p], set->m) == 0) {
+                (*found)++;
+                int stop = mcb ? mcb(p, pos, ctx) : bcb(textId, p, pos, ctx);
+                if (stop) {
+                    return 1;
+                }
             }
         }
+        slot = (slot + 1) & set->mask;
+    }
+    return 0;
+}
+
+// Один проход по тексту с проверкой каждого окна по набору
+static size_t rkSetScan(const RKSet* set, const char* text, size_t n, int textId,
+                        RK_MultiCallback mcb, RK_BatchCallback bcb, void* ctx,
+                        int* stopped) {
+    size_t m = set->m;
+    size_t found = 0;
+    *stopped = 0;
+    if (set->count == 0 || m > n) {
+        return 0;
+    }
+    
+    const unsigned char* T = (const unsigned char*)text;
+    uint64_t B = rkBase();
+    uint64_t h = rkPower(m, B);
+    uint64_t t = rkHash(T, m, B);
+    
+    for (size_t i = 0; i <= n - m; i++) {
+        if (rkSetProbe(set, text, i, t, textId, mcb, bcb, ctx, &found)) {
+            *stopped = 1;
+            break;
+        }
+        if (i < n - m) {
+            t = rkRoll(t, T[i], T[i + m], h, B);
+        }
+    }
+    return found;
+}
+
+// Поиск всех паттернов набора в тексте за один проход
+size_t RK_MultiSearch(const RKSet* set, const char* text, size_t n,
+                      RK_MultiCallback cb, void* ctx) {
+    int stopped;
+    return rkSetScan(set, text, n, 0, cb, NULL, ctx, &stopped);
+}
+
+// Поиск набора в пакете документов texts[0..count) с длинами lens[]
+size_t RK_SearchBatch(const RKSet* set, const char* const* texts,
+                      const size_t* lens, int count,
+                      RK_BatchCallback cb, void* ctx) {
+    size_t found = 0;
+    for (int i = 0; i < count; i++) {
+        int stopped;
+        found += rkSetScan(set, texts[i], lens[i], i, NULL, cb, ctx, &stopped);
+        if (stopped) {
+            break;
+        }
     }
+    return found;
 }
 
 // ============ СЛОЖНОСТЬ ============
 // Время: O(n + m) в среднем случае
-//        O(n*m) в худшем (много коллизий)
-// Память: O(1)
+//        O(n*m) в худшем - только если почти каждое окно - совпадение;
+//        ложные срабатывания по хэшу при модуле 2^61-1 практически исключены
+// Мультипоиск k паттернов длины m: O(km + n) в среднем
+// Память: O(1) для одного паттерна, O(k) - хэш-таблица набора
 // Хорошо работает для поиска нескольких паттернов одновременно
+//
+// Почему не int и q = 101:
+// - при q = 101 совпадает хэш примерно каждого сотого окна → лишние memcmp
+// - d * (t - text[i]*h) в int может переполниться (неопределённое поведение)
+// - 64-битная арифметика по модулю 2^61-1 через __int128 не переполняется
 
 // ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
 
 /*
+// Обработчик: печатает позицию и продолжает поиск
+int printMatch(size_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %zu\n", pos);
+    return 0;
+}
+
+int printAnimal(int pattern, size_t pos, void* ctx) {
+    const char* const* names = ctx;
+    printf("Найдено \"%s\" на позиции %zu\n", names[pattern], pos);
+    return 0;
+}
+
+int printDoc(int text, int pattern, size_t pos, void* ctx) {
+    const char* const* names = ctx;
+    printf("Документ %d: \"%s\" на позиции %zu\n", text, names[pattern], pos);
+    return 0;
+}
+
 int main() {
     printf("=== Алгоритм Рабина-Карпа ===\n\n");
     
@@ -70,7 +349,7 @@ int main() {
     char pattern1[] = "AABA";
     
     printf("Тест 1: Ищем \"%s\" в \"%s\"\n", pattern1, text1);
-    rabinKarp(text1, pattern1);
+    rabinKarp(text1, strlen(text1), pattern1, strlen(pattern1), printMatch, NULL);
     printf("\n");
     
     // Тест 2: Поиск в тексте
@@ -78,7 +357,7 @@ int main() {
     char pattern2[] = "test";
     
     printf("Тест 2: Ищем \"%s\" в \"%s\"\n", pattern2, text2);
-    rabinKarp(text2, pattern2);
+    rabinKarp(text2, strlen(text2), pattern2, strlen(pattern2), printMatch, NULL);
     printf("\n");
     
     // Тест 3: Паттерн не найден
@@ -86,7 +365,7 @@ int main() {
     char pattern3[] = "xyz";
     
     printf("Тест 3: Ищем \"%s\" в \"%s\"\n", pattern3, text3);
-    rabinKarp(text3, pattern3);
+    rabinKarp(text3, strlen(text3), pattern3, strlen(pattern3), printMatch, NULL);
     printf("(не найдено)\n\n");
     
     // Тест 4: Повторяющийся паттерн
@@ -94,9 +373,47 @@ int main() {
     char pattern4[] = "abab";
     
     printf("Тест 4: Ищем \"%s\" в \"%s\"\n", pattern4, text4);
-    rabinKarp(text4, pattern4);
+    rabinKarp(text4, strlen(text4), pattern4, strlen(pattern4), printMatch, NULL);
+    printf("\n");
+    
+    // Тест 5: Бинарные данные с нулевыми байтами и буфер результатов
+    const char bin[] = {'a', '\0', 'b', 'x', 'a', '\0', 'b', 'a', '\0', 'b'};
+    const char binPat[] = {'a', '\0', 'b'};
+    size_t positions[2];
+    SearchBuffer buf = {positions, 2, 0};
+    
+    printf("Тест 5: Бинарный текст, первые 2 вхождения \"a\\0b\"\n");
+    rabinKarp(bin, sizeof(bin), binPat, sizeof(binPat), Search_Collect, &buf);
+    for (size_t i = 0; i < buf.count; i++)
+        printf("Позиция %zu\n", positions[i]);  // 0, 4 (третье не ищем)
     printf("\n");
     
+    // Тест 6: Несколько паттернов одной длины за один проход
+    const char* animals[] = {"cat", "dog", "rat"};
+    RKSet set;
+    RK_SetBuild(&set, animals, 3, 3);
+    
+    const char* text6 = "the cat and the dog chased a rat";
+    printf("Тест 6: Ищем {cat, dog, rat} в \"%s\"\n", text6);
+    RK_MultiSearch(&set, text6, strlen(text6), printAnimal, animals);
+    printf("\n");
+    
+    // Тест 7: Пакет документов
+    const char* docs[] = {"my cat", "hot dog", "no pets"};
+    size_t docLens[] = {6, 7, 7};
+    printf("Тест 7: Пакет из 3 документов\n");
+    RK_SearchBatch(&set, docs, docLens, 3, printDoc, animals);
+    printf("\n");
+    RK_SetDestroy(&set);
+    
+    // Тест 8: Шинглы - одинаковые хэши окон у повторяющихся кусков
+    const char* text8 = "abcXabc";
+    uint64_t shingles[8];
+    size_t count = RK_HashWindows(text8, strlen(text8), 3, shingles);
+    printf("Тест 8: Шинглы длины 3 в \"%s\": %zu окон\n", text8, count);
+    printf("hash(\"abc\"@0) == hash(\"abc\"@4)? %s\n",
+           shingles[0] == shingles[4] ? "Да" : "Нет");  // Да
+    
     return 0;
 }
 */
@@ -0,0 +1,72 @@
+// Общий интерфейс алгоритмов поиска подстроки
+// Используется в kmp.c, bm.c, rk.c, simd_search.c
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// Все алгоритмы имеют вид:
+//   size_t Search(const char* text, size_t n, const char* pattern, size_t m,
+//                 SearchCallback cb, void* ctx)
+//   - длины передаются явно → работает с бинарными данными (нулевые байты)
+//     и не вызывает strlen на каждом вызове
+//   - каждое совпадение передаётся в cb(pos, ctx)
+//   - если cb вернул ненулевое значение - поиск останавливается
+//   - возвращает количество переданных в cb совпадений
+//
+// Готовые обработчики:
+//   Search_Collect - складывать позиции в буфер SearchBuffer
+//   Search_Count   - только считать совпадения (ctx - size_t*)
+//   Search_First   - запомнить первое совпадение и остановиться
+//
+// ==========================================
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stddef.h>
+
+// Обработчик совпадения: pos - позиция начала совпадения в тексте
+// Ненулевой результат останавливает поиск
+typedef int (*SearchCallback)(size_t pos, void* ctx);
+
+// Любой алгоритм поиска с этим интерфейсом: KMPSearch, boyerMooreSearch,
+// rabinKarp, simdSearch. Используется драйверами (параллельный поиск и т.п.)
+typedef size_t (*SearchFn)(const char* text, size_t n,
+                           const char* pattern, size_t m,
+                           SearchCallback cb, void* ctx);
+
+// Поиск КМП (kmp.c) - O(n) в худшем случае; им пользуются другие
+// алгоритмы как запасным путём (simdSearch на патологических паттернах).
+// kmp.c - отдельная единица трансляции: собирать вместе с ним
+size_t KMPSearch(const char* text, size_t n, const char* pattern, size_t m,
+                 SearchCallback cb, void* ctx);
+
+// Буфер результатов, выделенный вызывающим
+typedef struct {
+    size_t* pos;        // массив позиций
+    size_t capacity;    // его размер
+    size_t count;       // сколько позиций записано
+} SearchBuffer;
+
+// Записать позицию в буфер; когда буфер заполнен - остановить поиск
+static inline int Search_Collect(size_t pos, void* ctx) {
+    SearchBuffer* buf = (SearchBuffer*)ctx;
+    if (buf->count < buf->capacity) {
+        buf->pos[buf->count++] = pos;
+    }
+    return buf->count == buf->capacity;
+}
+
+// Только подсчёт: ctx указывает на size_t-счётчик
+static inline int Search_Count(size_t pos, void* ctx) {
+    (void)pos;
+    (*(size_t*)ctx)++;
+    return 0;
+}
+
+// Первое совпадение: ctx указывает на size_t, поиск сразу останавливается
+static inline int Search_First(size_t pos, void* ctx) {
+    *(size_t*)ctx = pos;
+    return 1;
+}
+
+#endif
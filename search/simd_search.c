@@ -0,0 +1,342 @@
+// SIMD-поиск подстроки (фильтр по первому и последнему байту)
+// Сравнение 16 (SSE2) или 32 (AVX2) позиций текста за одну инструкцию
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНАЯ ФУНКЦИЯ:
+//   size_t simdSearch(const char* text, size_t n, const char* pattern,
+//                     size_t m, SearchCallback cb, void* ctx)
+//   - интерфейс как у KMPSearch/boyerMooreSearch (search.h)
+//
+// ИДЕЯ:
+//   1. Размножаем первый и последний байт паттерна на весь вектор:
+//        F = [p0 p0 p0 ... p0],  L = [pm-1 pm-1 ... pm-1]
+//   2. Загружаем два куска текста: с позиции i и с позиции i + m - 1
+//   3. Сравниваем: (text[i+k] == p0) И (text[i+k+m-1] == pm-1)
+//      для 16/32 позиций k одновременно → битовая маска кандидатов
+//   4. Только кандидатов проверяем memcmp по средней части паттерна
+//
+//   Совпадение двух байт на случайной позиции - редкость, поэтому
+//   memcmp вызывается редко, а основной цикл - 4 векторные инструкции
+//   на 16/32 байта текста
+//
+// ВЫБОР РЕАЛИЗАЦИИ (во время выполнения):
+//   - AVX2, если процессор поддерживает (__builtin_cpu_supports;
+//     проверка - один раз на процесс, под pthread_once)
+//   - иначе SSE2 (есть на любом x86-64)
+//   - на других архитектурах - скалярный цикл с memchr
+//
+// ЗАЩИТА ОТ ПАТОЛОГИЧЕСКИХ ПАТТЕРНОВ:
+//   На "aaaa...a" в "aaaa...a" кандидат - каждая позиция, и memcmp даёт
+//   O(n·m). Считаем байты, проверенные memcmp; если их намного больше,
+//   чем просмотрено текста - остаток текста ищем KMPSearch за O(n)
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "search.h"   // KMPSearch - из kmp.c
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#endif
+
+// Переходить на КМП имеет смысл только для длинных паттернов:
+// для коротких memcmp кандидата дешевле одного шага КМП
+#define SIMD_FALLBACK_MIN_LEN 16
+// Допустимо проверить memcmp в столько раз больше байт, чем просмотрено
+#define SIMD_FALLBACK_RATIO 4
+// ... плюс запас, чтобы не переключаться из-за случайных кандидатов в начале
+#define SIMD_FALLBACK_SLACK 65536
+
+// Состояние сканирования, общее для всех реализаций
+typedef struct {
+    SearchCallback cb;
+    void* ctx;
+    size_t found;       // сколько совпадений передано в cb
+    size_t verified;    // сколько байт проверено memcmp
+    int stop;           // cb попросил остановиться
+    int fallback;       // слишком много ложных кандидатов - нужен КМП
+} SimdScan;
+
+// Проверка кандидата на позиции pos и, если совпал, - сообщение о нём
+static inline int simdCheck(SimdScan* st, const unsigned char* text,
+                            const unsigned char* pattern, size_t m, size_t pos) {
+    st->verified += m;
+    // Первый и последний байт уже совпали - сравниваем середину
+    if (m <= 2 || memcmp(text + pos + 1, pattern + 1, m - 2) == 0) {
+        st->found++;
+        if (st->cb(pos, st->ctx)) {
+            st->stop = 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Пора ли переходить на КМП: проверено слишком много байт
+static inline int simdTooManyCandidates(const SimdScan* st, size_t m, size_t scanned) {
+    return m >= SIMD_FALLBACK_MIN_LEN &&
+           st->verified > SIMD_FALLBACK_RATIO * scanned + SIMD_FALLBACK_SLACK;
+}
+
+#ifdef SIMD_X86
+
+// SSE2: 16 позиций за шаг. Возвращает первую непросмотренную позицию
+static size_t simdScanSSE2(SimdScan* st, const unsigned char* text, size_t n,
+                           const unsigned char* pattern, size_t m) {
+    const __m128i first = _mm_set1_epi8((char)pattern[0]);
+    const __m128i last = _mm_set1_epi8((char)pattern[m - 1]);
+    size_t i = 0;
+
+    for (; i + m + 15 <= n; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i*)(text + i));
+        __m128i blockLast = _mm_loadu_si128((const __m128i*)(text + i + m - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst),
+                                   _mm_cmpeq_epi8(last, blockLast));
+        unsigned mask = (unsigned)_mm_movemask_epi8(eq);
+
+        // Перебираем кандидатов от младшего бита - позиции по возрастанию
+        while (mask != 0) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (simdCheck(st, text, pattern, m, i + bit)) {
+                return i;
+            }
+            mask &= mask - 1;
+        }
+
+        if (simdTooManyCandidates(st, m, i + 16)) {
+            st->fallback = 1;
+            return i + 16;
+        }
+    }
+    return i;
+}
+
+// AVX2: 32 позиции за шаг
+__attribute__((target("avx2")))
+static size_t simdScanAVX2(SimdScan* st, const unsigned char* text, size_t n,
+                           const unsigned char* pattern, size_t m) {
+    const __m256i first = _mm256_set1_epi8((char)pattern[0]);
+    const __m256i last = _mm256_set1_epi8((char)pattern[m - 1]);
+    size_t i = 0;
+
+    for (; i + m + 31 <= n; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(text + i));
+        __m256i blockLast = _mm256_loadu_si256((const __m256i*)(text + i + m - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst),
+                                      _mm256_cmpeq_epi8(last, blockLast));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(eq);
+
+        while (mask != 0) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (simdCheck(st, text, pattern, m, i + bit)) {
+                return i;
+            }
+            mask &= mask - 1;
+        }
+
+        if (simdTooManyCandidates(st, m, i + 32)) {
+            st->fallback = 1;
+            return i + 32;
+        }
+    }
+    return i;
+}
+
+#endif
+
+// Скалярная реализация: memchr по первому байту + проверка последнего
+static size_t simdScanScalar(SimdScan* st, const unsigned char* text, size_t n,
+                             const unsigned char* pattern, size_t m) {
+    size_t i = 0;
+    while (i + m <= n) {
+        const unsigned char* hit = memchr(text + i, pattern[0], n - m + 1 - i);
+        if (hit == NULL) {
+            return n - m + 1;
+        }
+        i = (size_t)(hit - text);
+        if (text[i + m - 1] == pattern[m - 1] &&
+            simdCheck(st, text, pattern, m, i)) {
+            return i;
+        }
+        i++;
+        if (simdTooManyCandidates(st, m, i)) {
+            st->fallback = 1;
+            return i;
+        }
+    }
+    return i;
+}
+
+typedef size_t (*SimdScanFn)(SimdScan*, const unsigned char*, size_t,
+                             const unsigned char*, size_t);
+
+static SimdScanFn simdChosen;
+static pthread_once_t simdOnce = PTHREAD_ONCE_INIT;
+
+static void simdSelectInit(void) {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        simdChosen = simdScanAVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        simdChosen = simdScanSSE2;
+    } else {
+        simdChosen = simdScanScalar;
+    }
+#else
+    simdChosen = simdScanScalar;
+#endif
+}
+
+// Выбор реализации под процессор - один раз на процесс
+// (pthread_once: первыми поиск могут начать сразу несколько потоков)
+static SimdScanFn simdSelect(void) {
+    pthread_once(&simdOnce, simdSelectInit);
+    return simdChosen;
+}
+
+// Передача совпадений КМП со сдвигом позиций на offset
+typedef struct {
+    SimdScan* st;
+    size_t offset;
+} SimdOffset;
+
+static int simdOffsetCallback(size_t pos, void* ctx) {
+    SimdOffset* o = (SimdOffset*)ctx;
+    if (o->st->cb(pos + o->offset, o->st->ctx)) {
+        o->st->stop = 1;
+        return 1;
+    }
+    return 0;
+}
+
+// Поиск всех вхождений pattern (длины m) в text (длины n)
+// Каждое совпадение передаётся в cb; ненулевой ответ cb останавливает поиск
+// Возвращает количество найденных (переданных в cb) совпадений
+size_t simdSearch(const char* text, size_t n, const char* pattern, size_t m,
+                  SearchCallback cb, void* ctx) {
+    if (m == 0 || m > n) {
+        return 0;
+    }
+
+    const unsigned char* t = (const unsigned char*)text;
+    const unsigned char* p = (const unsigned char*)pattern;
+    SimdScan st = {cb, ctx, 0, 0, 0, 0};
+
+    size_t i = simdSelect()(&st, t, n, p, m);
+    if (st.stop) {
+        return st.found;
+    }
+
+    if (st.fallback) {
+        // Патологический паттерн - остаток текста ищем КМП за O(n)
+        SimdOffset o = {&st, i};
+        st.found += KMPSearch(text + i, n - i, pattern, m, simdOffsetCallback, &o);
+        return st.found;
+    }
+
+    // Хвост, не поместившийся в целый вектор
+    for (; i + m <= n; i++) {
+        if (t[i] == p[0] && t[i + m - 1] == p[m - 1] &&
+            simdCheck(&st, t, p, m, i)) {
+            break;
+        }
+    }
+    return st.found;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// Время: O(n / W) векторных шагов + O(m) на каждого кандидата,
+//        W = 16 (SSE2) или 32 (AVX2)
+//        O(n + m) в худшем случае благодаря переходу на КМП
+// Память: O(1) (O(m) при переходе на КМП)
+//
+// Особенности:
+// - На обычном тексте десятки ГБ/с ограничены пропускной способностью
+//   памяти, а не процессором
+// - Лучше Бойера-Мура на коротких паттернах (m < 8), где BM почти
+//   не получает длинных сдвигов
+// - Фильтр по двум байтам вместо одного: ложных кандидатов в ~σ раз меньше,
+//   чем у memchr по первому байту
+// - Сравнения идут по байтам - работает с UTF-8 и бинарными данными
+// - Используется в glibc memmem, ripgrep (memchr crate), Hyperscan
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <time.h>
+#include "kmp.c"
+#include "bm.c"
+
+int printMatch(size_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %zu\n", pos);
+    return 0;
+}
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    printf("=== SIMD-поиск подстроки ===\n\n");
+
+    // Тест 1: Простой поиск
+    const char* text1 = "haystack with needle inside haystack with needle";
+    printf("Тест 1: Ищем \"needle\"\n");
+    simdSearch(text1, strlen(text1), "needle", 6, printMatch, NULL);  // 14, 42
+    printf("\n");
+
+    // Тест 2: Патологический паттерн - переход на КМП
+    size_t n = 64 << 20;
+    char* text = malloc(n);
+    memset(text, 'a', n);
+    char bad[64];
+    memset(bad, 'a', 63);
+    bad[31] = 'b';
+    bad[63] = '\0';
+
+    size_t count = 0;
+    double t0 = now();
+    simdSearch(text, n, bad, 63, Search_Count, &count);
+    printf("Тест 2: \"a..aba..a\" в \"aaaa...\": %zu совпадений, %.3f с\n\n",
+           count, now() - t0);
+
+    // Тест 3: Бенчмарк на случайном тексте
+    srand(1);
+    for (size_t i = 0; i < n; i++)
+        text[i] = 'a' + rand() % 26;
+    const char* pat = "pattern";
+    memcpy(text + n - 7, pat, 7);
+
+    printf("Тест 3: Бенчмарк, %zu МБ, паттерн \"%s\"\n", n >> 20, pat);
+
+    count = 0;
+    t0 = now();
+    simdSearch(text, n, pat, 7, Search_Count, &count);
+    double t1 = now();
+    printf("simdSearch:       %.2f ГБ/с (%zu)\n", n / (t1 - t0) / 1e9, count);
+
+    count = 0;
+    t0 = now();
+    boyerMooreSearch(text, n, pat, 7, Search_Count, &count);
+    t1 = now();
+    printf("boyerMooreSearch: %.2f ГБ/с (%zu)\n", n / (t1 - t0) / 1e9, count);
+
+    count = 0;
+    t0 = now();
+    KMPSearch(text, n, pat, 7, Search_Count, &count);
+    t1 = now();
+    printf("KMPSearch:        %.2f ГБ/с (%zu)\n", n / (t1 - t0) / 1e9, count);
+
+    free(text);
+    return 0;
+}
+*/
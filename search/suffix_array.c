@@ -0,0 +1,417 @@
+// Суффиксный массив + LCP (индекс для многократного поиска)
+// Текст обрабатывается один раз, после чего каждый запрос - O(m log n)
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНЫЕ ФУНКЦИИ:
+//   bool   SA_Build(SuffixArray* sa, const char* text, size_t n)
+//   size_t SA_Count(const SuffixArray* sa, const char* pattern, size_t m)
+//   size_t SA_Locate(const SuffixArray* sa, const char* pattern, size_t m,
+//                    SearchCallback cb, void* ctx)
+//   bool   SA_Save(const SuffixArray* sa, const char* path)
+//   bool   SA_Open(SuffixArray* sa, const char* path, const char* text, size_t n)
+//   void   SA_Destroy(SuffixArray* sa)
+//
+// СУФФИКСНЫЙ МАССИВ:
+//   sa[] - начала всех суффиксов текста в лексикографическом порядке
+//
+//   Текст: "banana"        i  sa[i]  суффикс   lcp[i]
+//                          0    5    a           0
+//                          1    3    ana         1
+//                          2    1    anana       3
+//                          3    0    banana      0
+//                          4    4    na          0
+//                          5    2    nana        2
+//
+//   Все вхождения паттерна - начала суффиксов, которые начинаются
+//   с паттерна. В отсортированном массиве они идут ПОДРЯД → два
+//   бинарных поиска дают границы [lo, hi): count = hi - lo
+//
+// ПОСТРОЕНИЕ (удвоение префиксов с поразрядной сортировкой):
+//   - На шаге k суффиксы упорядочены по первым k символам, rank[i] - класс
+//   - Пара (rank[i], rank[i + k]) упорядочивает по 2k символам:
+//     две сортировки подсчётом (как в radix sort) - O(n) на шаг
+//   - Шагов не больше log n → O(n log n)
+//
+// LCP (алгоритм Касаи):
+//   lcp[i] - длина общего префикса суффиксов sa[i-1] и sa[i].
+//   Если у суффикса i общий префикс h с соседом, то у суффикса i+1 -
+//   не меньше h-1 → весь массив за O(n)
+//
+// ФАЙЛ ИНДЕКСА:
+//   [заголовок][sa: n × uint32][lcp: n × uint32]
+//   SA_Open отображает файл через mmap - индекс готов к работе сразу,
+//   без чтения и копирования, страницы подгружаются по мере запросов
+//   Сам текст в индекс не входит - его передают отдельно (тоже можно mmap)
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "search.h"
+
+#define SA_MAGIC 0x58444953u  // "SIDX"
+#define SA_VERSION 1u
+
+typedef struct {
+    const unsigned char* text;  // текст (не принадлежит индексу)
+    uint32_t n;                 // длина текста (< 2^32)
+    uint32_t* sa;               // суффиксный массив
+    uint32_t* lcp;              // lcp[i] = LCP(sa[i-1], sa[i]), lcp[0] = 0
+    void* map;                  // отображённый файл (SA_Open) или NULL
+    size_t mapLen;
+} SuffixArray;
+
+// Заголовок файла индекса
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t n;
+} SAHeader;
+
+// Построение суффиксного массива удвоением префиксов
+static void saConstruct(const unsigned char* t, uint32_t n, uint32_t* sa) {
+    uint32_t* rank = malloc(sizeof(uint32_t) * n);
+    uint32_t* tmp = malloc(sizeof(uint32_t) * n);
+    uint32_t classes = 256;
+    uint32_t* count = malloc(sizeof(uint32_t) * (n > 256 ? n : 256));
+
+    // Шаг 0: сортировка подсчётом по первому символу
+    memset(count, 0, sizeof(uint32_t) * 256);
+    for (uint32_t i = 0; i < n; i++) {
+        count[t[i]]++;
+    }
+    for (uint32_t c = 1; c < 256; c++) {
+        count[c] += count[c - 1];
+    }
+    for (uint32_t i = n; i-- > 0;) {
+        sa[--count[t[i]]] = i;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        rank[i] = t[i];
+    }
+
+    // k и суммы a + k - в size_t: при n > 2^31 удвоение k и сумма
+    // в uint32_t переполнились бы
+    for (size_t k = 1; ; k <<= 1) {
+        // Сортировка по второму ключу rank[i + k]: суффиксы без второй
+        // половины (i + k >= n) - самые маленькие, остальные - в порядке sa
+        uint32_t p = 0;
+        for (uint32_t i = n - (uint32_t)(k < n ? k : n); i < n; i++) {
+            tmp[p++] = i;
+        }
+        for (uint32_t j = 0; j < n; j++) {
+            if (sa[j] >= k) {
+                tmp[p++] = sa[j] - (uint32_t)k;
+            }
+        }
+
+        // Устойчивая сортировка подсчётом по первому ключу rank[i]
+        memset(count, 0, sizeof(uint32_t) * classes);
+        for (uint32_t i = 0; i < n; i++) {
+            count[rank[i]]++;
+        }
+        for (uint32_t c = 1; c < classes; c++) {
+            count[c] += count[c - 1];
+        }
+        for (uint32_t j = n; j-- > 0;) {
+            sa[--count[rank[tmp[j]]]] = tmp[j];
+        }
+
+        // Новые классы: соседние пары различаются → новый класс
+        tmp[sa[0]] = 0;
+        classes = 1;
+        for (uint32_t j = 1; j < n; j++) {
+            uint32_t a = sa[j - 1], b = sa[j];
+            uint32_t a2 = ((size_t)a + k < n) ? rank[a + k] + 1 : 0;
+            uint32_t b2 = ((size_t)b + k < n) ? rank[b + k] + 1 : 0;
+            if (rank[a] != rank[b] || a2 != b2) {
+                classes++;
+            }
+            tmp[b] = classes - 1;
+        }
+        memcpy(rank, tmp, sizeof(uint32_t) * n);
+
+        // Все суффиксы различны - порядок окончательный
+        if (classes == n || k >= n) {
+            break;
+        }
+    }
+
+    free(rank);
+    free(tmp);
+    free(count);
+}
+
+// LCP соседних суффиксов - алгоритм Касаи, O(n)
+static void saBuildLCP(const unsigned char* t, uint32_t n,
+                       const uint32_t* sa, uint32_t* lcp) {
+    uint32_t* inv = malloc(sizeof(uint32_t) * n);  // inv[sa[i]] = i
+    for (uint32_t i = 0; i < n; i++) {
+        inv[sa[i]] = i;
+    }
+
+    uint32_t h = 0;
+    lcp[0] = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (inv[i] == 0) {
+            h = 0;
+            continue;
+        }
+        uint32_t j = sa[inv[i] - 1];  // предыдущий суффикс в порядке sa
+        while (i + h < n && j + h < n && t[i + h] == t[j + h]) {
+            h++;
+        }
+        lcp[inv[i]] = h;
+        if (h > 0) {
+            h--;  // следующий суффикс совпадает с соседом хотя бы на h - 1
+        }
+    }
+
+    free(inv);
+}
+
+// Построить индекс по тексту (текст должен жить, пока жив индекс)
+// Позиции хранятся в uint32_t: текст длиной 2^32 - 1 и больше
+// не индексируется - false
+bool SA_Build(SuffixArray* sa, const char* text, size_t n) {
+    memset(sa, 0, sizeof(*sa));
+    if (n == 0 || n >= UINT32_MAX) {
+        return false;
+    }
+    sa->text = (const unsigned char*)text;
+    sa->n = (uint32_t)n;
+    sa->sa = malloc(sizeof(uint32_t) * n);
+    sa->lcp = malloc(sizeof(uint32_t) * n);
+    saConstruct(sa->text, sa->n, sa->sa);
+    saBuildLCP(sa->text, sa->n, sa->sa, sa->lcp);
+    return true;
+}
+
+// Сравнить суффикс, начинающийся в pos, с паттерном по первым m символам
+// < 0 - суффикс меньше, 0 - начинается с паттерна, > 0 - больше
+static int saCompare(const SuffixArray* sa, uint32_t pos,
+                     const unsigned char* pattern, size_t m) {
+    size_t len = sa->n - pos;
+    int r = memcmp(sa->text + pos, pattern, len < m ? len : m);
+    if (r == 0 && len < m) {
+        return -1;  // суффикс - собственный префикс паттерна
+    }
+    return r;
+}
+
+// Границы [lo, hi) суффиксов, начинающихся с паттерна
+static void saRange(const SuffixArray* sa, const char* pattern, size_t m,
+                    uint32_t* lo, uint32_t* hi) {
+    const unsigned char* p = (const unsigned char*)pattern;
+
+    // Первый суффикс >= паттерна
+    uint32_t L = 0, R = sa->n;
+    while (L < R) {
+        uint32_t mid = L + (R - L) / 2;
+        if (saCompare(sa, sa->sa[mid], p, m) < 0) {
+            L = mid + 1;
+        } else {
+            R = mid;
+        }
+    }
+    *lo = L;
+
+    // Первый суффикс, который больше паттерна и не начинается с него
+    R = sa->n;
+    while (L < R) {
+        uint32_t mid = L + (R - L) / 2;
+        if (saCompare(sa, sa->sa[mid], p, m) <= 0) {
+            L = mid + 1;
+        } else {
+            R = mid;
+        }
+    }
+    *hi = L;
+}
+
+// Количество вхождений паттерна - O(m log n)
+size_t SA_Count(const SuffixArray* sa, const char* pattern, size_t m) {
+    if (m == 0 || sa->n == 0) {
+        return 0;
+    }
+    uint32_t lo, hi;
+    saRange(sa, pattern, m, &lo, &hi);
+    return hi - lo;
+}
+
+// Все вхождения паттерна - O(m log n + z)
+// Позиции передаются в cb в порядке суффиксов (не по возрастанию!)
+// Ненулевой ответ cb останавливает перечисление
+size_t SA_Locate(const SuffixArray* sa, const char* pattern, size_t m,
+                 SearchCallback cb, void* ctx) {
+    if (m == 0 || sa->n == 0) {
+        return 0;
+    }
+    uint32_t lo, hi;
+    saRange(sa, pattern, m, &lo, &hi);
+
+    size_t found = 0;
+    for (uint32_t i = lo; i < hi; i++) {
+        found++;
+        if (cb(sa->sa[i], ctx)) {
+            break;
+        }
+    }
+    return found;
+}
+
+// Сохранить индекс (sa и lcp) в файл
+bool SA_Save(const SuffixArray* sa, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    SAHeader h = {SA_MAGIC, SA_VERSION, sa->n};
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+              fwrite(sa->sa, sizeof(uint32_t), sa->n, f) == sa->n &&
+              fwrite(sa->lcp, sizeof(uint32_t), sa->n, f) == sa->n;
+    return (fclose(f) == 0) && ok;
+}
+
+// Открыть сохранённый индекс через mmap для текста text длины n
+// Проверяет заголовок и что индекс построен для текста той же длины
+bool SA_Open(SuffixArray* sa, const char* path, const char* text, size_t n) {
+    memset(sa, 0, sizeof(*sa));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    size_t expected = sizeof(SAHeader) + 2 * sizeof(uint32_t) * n;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size != expected) {
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(NULL, expected, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // отображение остаётся действительным после close
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    const SAHeader* h = (const SAHeader*)map;
+    if (h->magic != SA_MAGIC || h->version != SA_VERSION || h->n != n) {
+        munmap(map, expected);
+        return false;
+    }
+
+    sa->text = (const unsigned char*)text;
+    sa->n = (uint32_t)n;
+    sa->sa = (uint32_t*)((char*)map + sizeof(SAHeader));
+    sa->lcp = sa->sa + n;
+    sa->map = map;
+    sa->mapLen = expected;
+    return true;
+}
+
+void SA_Destroy(SuffixArray* sa) {
+    if (sa->map != NULL) {
+        munmap(sa->map, sa->mapLen);
+    } else {
+        free(sa->sa);
+        free(sa->lcp);
+    }
+    memset(sa, 0, sizeof(*sa));
+}
+
+// ============ СЛОЖНОСТЬ ============
+// Построение: O(n log n) - удвоение префиксов (log n шагов по O(n))
+// LCP: O(n) - алгоритм Касаи
+// SA_Count: O(m log n)
+// SA_Locate: O(m log n + z), z - число вхождений
+// Память: 8n байт (sa + lcp) + текст; при построении ещё ~12n
+// SA_Open: O(1) - файл отображается, а не читается
+//
+// Сравнение с онлайн-алгоритмами (КМП, БМ):
+// - КМП/БМ: O(n) на КАЖДЫЙ запрос - весь текст заново
+// - Суффиксный массив: O(n log n) один раз, затем O(m log n) на запрос
+// - Тысячи запросов к одному корпусу в ГБ - разница в миллионы раз
+//
+// Особенности:
+// - Индексы 32-битные: текст до 4 ГБ (для больших - разбить на части
+//   или перейти на uint64_t ценой удвоения памяти)
+// - Формат файла - в порядке байт машины, переносим между машинами
+//   с одинаковым порядком байт
+// - LCP даёт наибольшую повторяющуюся подстроку (max lcp), число
+//   различных подстрок (n(n+1)/2 - Σ lcp) и ускоренный поиск
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <time.h>
+
+int printMatch(size_t pos, void* ctx) {
+    (void)ctx;
+    printf("Найдено на позиции %zu\n", pos);
+    return 0;
+}
+
+int main() {
+    printf("=== Суффиксный массив + LCP ===\n\n");
+
+    // Тест 1: Построение для "banana"
+    const char* text1 = "banana";
+    SuffixArray sa;
+    SA_Build(&sa, text1, 6);
+
+    printf("Тест 1: Суффиксный массив \"%s\"\n", text1);
+    for (uint32_t i = 0; i < sa.n; i++)
+        printf("sa[%u]=%u lcp=%u  %s\n", i, sa.sa[i], sa.lcp[i], text1 + sa.sa[i]);
+    printf("\n");
+
+    // Тест 2: Запросы
+    printf("Тест 2: count(\"ana\") = %zu\n", SA_Count(&sa, "ana", 3));  // 2
+    SA_Locate(&sa, "ana", 3, printMatch, NULL);  // 3, 1
+    printf("count(\"nab\") = %zu\n\n", SA_Count(&sa, "nab", 3));  // 0
+    SA_Destroy(&sa);
+
+    // Тест 3: Большой корпус, сохранение и открытие через mmap
+    size_t n = 16 << 20;
+    char* corpus = malloc(n);
+    srand(1);
+    for (size_t i = 0; i < n; i++)
+        corpus[i] = "ACGT"[rand() % 4];
+
+    clock_t t0 = clock();
+    SA_Build(&sa, corpus, n);
+    printf("Тест 3: построение для %zu МБ: %.2f с\n", n >> 20,
+           (double)(clock() - t0) / CLOCKS_PER_SEC);
+
+    uint32_t best = 0;
+    for (uint32_t i = 0; i < sa.n; i++)
+        if (sa.lcp[i] > best) best = sa.lcp[i];
+    printf("Наибольшая повторяющаяся подстрока: %u символов\n", best);
+
+    SA_Save(&sa, "/tmp/corpus.sidx");
+    SA_Destroy(&sa);
+
+    SA_Open(&sa, "/tmp/corpus.sidx", corpus, n);
+    t0 = clock();
+    size_t total = 0;
+    for (int q = 0; q < 100000; q++) {
+        size_t at = (size_t)rand() % (n - 12);
+        total += SA_Count(&sa, corpus + at, 12);
+    }
+    printf("100000 запросов после SA_Open: %.3f с (%zu вхождений)\n",
+           (double)(clock() - t0) / CLOCKS_PER_SEC, total);
+
+    SA_Destroy(&sa);
+    remove("/tmp/corpus.sidx");
+    free(corpus);
+    return 0;
+}
+*/
@@ -60,31 +60,31 @@ int partition(int arr[], int left, int right) {
     // Выбираем опорный элемент (средний элемент диапазона)
     int pivot = arr[(left + right) / 2];
     
-    // Пока указатели не встретились
-    while (left < right) {
+    // Указатели стартуют за границами: каждый шаг сначала сдвигает их,
+    // поэтому после обмена оба элемента гарантированно перепроверяются
+    int i = left - 1;
+    int j = right + 1;
+    
+    while (1) {
         // Двигаем левый указатель вправо, пока элементы меньше опорного
-        while (arr[left] < pivot) {
-            left++;
-        }
+        do {
+            i++;
+        } while (arr[i] < pivot);
         
         // Двигаем правый указатель влево, пока элементы больше опорного
-        while (arr[right] > pivot) {
-            right--;
-        }
+        do {
+            j--;
+        } while (arr[j] > pivot);
         
-        // Если указатели встретились или пересеклись - пропускаем swap
-        if (left >= right) {
-            continue;
+        // Указатели встретились или пересеклись - разделение готово:
+        // все элементы [left, j] <= pivot <= все элементы [j+1, right]
+        if (i >= j) {
+            return j;
         }
         
-        // Меняем элементы местами и сдвигаем оба указателя
-        swap(&arr[left], &arr[right]);
-        left++;
-        right--;
+        // Меняем элементы местами
+        swap(&arr[i], &arr[j]);
     }
-    
-    // Возвращаем позицию разделения
-    return right;
 }
 
 // Нерекурсивная быстрая сортировка
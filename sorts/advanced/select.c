@@ -0,0 +1,345 @@
+// Порядковые статистики: nth_element, partial_sort и потоковый top-k
+// Частичная сортировка на основе разделения Хоара и кучи
+//
+// ============ КРАТКАЯ СПРАВКА ============
+//
+// ОСНОВНЫЕ ФУНКЦИИ:
+//   void nth_element(int arr[], int n, int k)  - поставить k-й по величине
+//                                                элемент на место k
+//   void partial_sort(int arr[], int n, int k) - k наименьших элементов
+//                                                в начало, по возрастанию
+//   TopK_Create / TopK_Push / TopK_Extract / TopK_Destroy
+//                                              - k наименьших из потока
+//
+// ИДЕЯ (Quickselect):
+//   1. Разделяем массив через partition() (как в hoar_rec.c):
+//      [left, m] <= pivot <= [m+1, right]
+//   2. В отличие от quickSort, продолжаем ТОЛЬКО в той части,
+//      где лежит позиция k - вторая часть уже "на своей стороне"
+//   3. В среднем n + n/2 + n/4 + ... = O(n)
+//
+// ЗАЩИТА ОТ ХУДШЕГО СЛУЧАЯ (Introselect):
+//   - Даём quickselect не более 2*log2(n) разделений
+//   - Если бюджет исчерпан (неудачные опорные), опорный элемент выбираем
+//     методом медианы медиан (BFPRT): он гарантированно отсекает
+//     не меньше 30% элементов → O(n) в худшем случае
+//
+// ПОТОКОВЫЙ TOP-K:
+//   - Max-куча из k элементов (Heapify, как в heap.c)
+//   - Корень - наибольший из k лучших; новый элемент меньше корня
+//     заменяет его и просеивается вниз
+//   - Память O(k), поток может быть сколь угодно длинным
+//
+// ==========================================
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// ============ ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ ============
+// Локальные копии swap()/partition() из hoar_rec.c и Heapify()/HeapSort()
+// из heap.c: файл самостоятельный и не тянет чужие определения
+
+static void swap(int* a, int* b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Разделение Хоара, как в hoar_rec.c:
+// [left, m] <= pivot <= [m+1, right], опорный - средний элемент
+static int partition(int arr[], int left, int right) {
+    int pivot = arr[(left + right) / 2];
+    int i = left - 1;
+    int j = right + 1;
+
+    while (1) {
+        do {
+            i++;
+        } while (arr[i] < pivot);
+
+        do {
+            j--;
+        } while (arr[j] > pivot);
+
+        if (i >= j) {
+            return j;
+        }
+        swap(&arr[i], &arr[j]);
+    }
+}
+
+// Просеивание вниз в max-куче, как в heap.c
+static void Heapify(int* arr, int size, int i) {
+    while (1) {
+        int max = i;
+        int left = 2 * i + 1;
+        int right = 2 * i + 2;
+
+        if (left < size && arr[left] > arr[max]) {
+            max = left;
+        }
+        if (right < size && arr[right] > arr[max]) {
+            max = right;
+        }
+        if (max == i) {
+            return;
+        }
+        swap(&arr[i], &arr[max]);
+        i = max;
+    }
+}
+
+// Пирамидальная сортировка, как в heap.c
+static void HeapSort(int* arr, int size) {
+    for (int i = size / 2 - 1; i >= 0; i--) {
+        Heapify(arr, size, i);
+    }
+    for (int i = size - 1; i > 0; i--) {
+        swap(&arr[0], &arr[i]);
+        Heapify(arr, i, 0);
+    }
+}
+
+// ============ QUICKSELECT ============
+
+// Сортировка вставками маленького диапазона [left, right] (группы по 5)
+static void smallSort(int arr[], int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        int x = arr[i];
+        int j = i - 1;
+        while (j >= left && arr[j] > x) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = x;
+    }
+}
+
+static void selectMedianOfMedians(int arr[], int left, int right, int k);
+
+// Медиана медиан: возвращает индекс опорного элемента в [left, right]
+// 1. Делим на группы по 5 и сортируем каждую
+// 2. Медианы групп переносим в начало диапазона
+// 3. Рекурсивно находим медиану этих медиан
+static int medianOfMedians(int arr[], int left, int right) {
+    int n = right - left + 1;
+
+    if (n <= 5) {
+        smallSort(arr, left, right);
+        return left + (n - 1) / 2;
+    }
+
+    int count = 0;  // Сколько медиан уже собрано в начале
+    for (int i = left; i <= right; i += 5) {
+        int groupRight = (i + 4 < right) ? i + 4 : right;
+        smallSort(arr, i, groupRight);
+        swap(&arr[left + count], &arr[i + (groupRight - i) / 2]);
+        count++;
+    }
+
+    int mid = left + (count - 1) / 2;
+    selectMedianOfMedians(arr, left, left + count - 1, mid);
+    return mid;
+}
+
+// Разделение с заранее выбранным опорным элементом:
+// partition() берёт опорный из середины, поэтому ставим его туда
+static int partitionAround(int arr[], int left, int right, int pivotIndex) {
+    swap(&arr[pivotIndex], &arr[(left + right) / 2]);
+    return partition(arr, left, right);
+}
+
+// Выбор k-го элемента только через медиану медиан - O(n) всегда
+static void selectMedianOfMedians(int arr[], int left, int right, int k) {
+    while (left < right) {
+        int m = partitionAround(arr, left, right,
+                                medianOfMedians(arr, left, right));
+        if (k <= m) {
+            right = m;
+        } else {
+            left = m + 1;
+        }
+    }
+}
+
+// Поставить на место k элемент, который стоял бы там после сортировки
+// После вызова: arr[0..k) <= arr[k] <= arr(k..n)
+void nth_element(int arr[], int n, int k) {
+    if (k < 0 || k >= n) {
+        return;
+    }
+
+    int left = 0;
+    int right = n - 1;
+
+    // Бюджет разделений для обычного quickselect: 2 * log2(n)
+    int budget = 0;
+    for (int size = n; size > 1; size /= 2) {
+        budget += 2;
+    }
+
+    while (left < right) {
+        if (budget-- == 0) {
+            // Опорные элементы неудачные - переходим на медиану медиан
+            selectMedianOfMedians(arr, left, right, k);
+            return;
+        }
+
+        // Разделяем массив на две части
+        int m = partition(arr, left, right);
+
+        // Продолжаем только в части, содержащей позицию k
+        if (k <= m) {
+            right = m;
+        } else {
+            left = m + 1;
+        }
+    }
+}
+
+// Частичная сортировка: arr[0..k) - k наименьших элементов по возрастанию
+// Порядок остальных элементов arr[k..n) не определён
+void partial_sort(int arr[], int n, int k) {
+    if (k <= 0) {
+        return;
+    }
+    if (k > n) {
+        k = n;
+    }
+
+    // ЭТАП 1: k наименьших собираются слева за O(n)
+    if (k < n) {
+        nth_element(arr, n, k - 1);
+    }
+
+    // ЭТАП 2: сортируем только их за O(k log k)
+    HeapSort(arr, k);
+}
+
+// ============ ПОТОКОВЫЙ TOP-K ============
+
+// k наименьших элементов потока
+typedef struct {
+    int* heap;   // max-куча: heap[0] - наибольший из отобранных
+    int size;    // сколько элементов уже отобрано
+    int k;       // сколько нужно отобрать
+} TopK;
+
+void TopK_Create(TopK* t, int k) {
+    t->heap = malloc(sizeof(int) * (k > 0 ? k : 1));
+    t->size = 0;
+    t->k = k;
+}
+
+// Обработать очередной элемент потока - O(log k)
+void TopK_Push(TopK* t, int x) {
+    if (t->size < t->k) {
+        t->heap[t->size++] = x;
+
+        // Набрали k элементов - строим max-кучу
+        if (t->size == t->k) {
+            for (int i = t->k / 2 - 1; i >= 0; i--) {
+                Heapify(t->heap, t->k, i);
+            }
+        }
+        return;
+    }
+
+    // Элемент меньше наибольшего из отобранных - заменяем корень
+    if (t->k > 0 && x < t->heap[0]) {
+        t->heap[0] = x;
+        Heapify(t->heap, t->k, 0);
+    }
+}
+
+// Скопировать отобранные элементы в out по возрастанию
+// Возвращает их количество (min(k, число элементов в потоке))
+int TopK_Extract(const TopK* t, int out[]) {
+    for (int i = 0; i < t->size; i++) {
+        out[i] = t->heap[i];
+    }
+    HeapSort(out, t->size);
+    return t->size;
+}
+
+void TopK_Destroy(TopK* t) {
+    free(t->heap);
+    t->heap = NULL;
+    t->size = 0;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// nth_element:  O(n) в среднем, O(n) в худшем (медиана медиан)
+// partial_sort: O(n + k log k)
+// TopK_Push:    O(log k) на элемент, весь поток - O(n log k)
+// TopK_Extract: O(k log k)
+// Память: O(1) для nth_element/partial_sort (in-place),
+//         O(k) для потокового top-k
+//
+// Сравнение с полной сортировкой quickSort - O(n log n):
+// - Медиана / перцентиль: nth_element - O(n)
+// - 10 наименьших из 100M: partial_sort - O(n), почти одна проходка
+// - Данные не помещаются в память: потоковый TopK, O(k) памяти
+//
+// Особенности:
+// - Не стабильные (как и quickSort/HeapSort)
+// - Медиана медиан медленнее обычного quickselect в ~3-5 раз,
+//   поэтому включается только при неудачных опорных элементах
+// - Равные элементы partition() делит между частями поровну,
+//   так что массивы из одинаковых значений не вырождаются
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+int main() {
+    printf("=== Порядковые статистики ===\n\n");
+
+    // Тест 1: Медиана
+    int arr1[] = {9, 1, 8, 2, 7, 3, 6, 4, 5};
+    int n1 = sizeof(arr1) / sizeof(arr1[0]);
+
+    printf("Тест 1: Медиана\n");
+    nth_element(arr1, n1, n1 / 2);
+    printf("Медиана: %d\n\n", arr1[n1 / 2]); // 5
+
+    // Тест 2: 3 наименьших по возрастанию
+    int arr2[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+    int n2 = sizeof(arr2) / sizeof(arr2[0]);
+
+    printf("Тест 2: partial_sort(k = 3)\n");
+    partial_sort(arr2, n2, 3);
+    printf("Наименьшие: ");
+    for (int i = 0; i < 3; i++)
+        printf("%d ", arr2[i]); // 1 1 2
+    printf("\n\n");
+
+    // Тест 3: Потоковый top-k
+    printf("Тест 3: 5 наименьших из потока 1000 чисел\n");
+    TopK t;
+    TopK_Create(&t, 5);
+    for (int i = 0; i < 1000; i++)
+        TopK_Push(&t, (i * 7919) % 1000);
+    int best[5];
+    int cnt = TopK_Extract(&t, best);
+    for (int i = 0; i < cnt; i++)
+        printf("%d ", best[i]); // 0 1 2 3 4
+    printf("\n\n");
+    TopK_Destroy(&t);
+
+    // Тест 4: Перцентили большого массива (вырожденные данные)
+    int n4 = 1000000;
+    int* arr4 = malloc(sizeof(int) * n4);
+    for (int i = 0; i < n4; i++)
+        arr4[i] = i % 2 ? i : n4 - i;  // "пила" - плохой случай для середины
+
+    printf("Тест 4: Перцентили 1M элементов\n");
+    int p50 = n4 / 2, p99 = n4 / 100 * 99;
+    nth_element(arr4, n4, p50);
+    printf("p50 = %d\n", arr4[p50]);
+    nth_element(arr4, n4, p99);
+    printf("p99 = %d\n", arr4[p99]);
+    free(arr4);
+
+    return 0;
+}
+*/
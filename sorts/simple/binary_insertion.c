@@ -6,6 +6,13 @@
 // ОСНОВНАЯ ФУНКЦИЯ:
 //   void BinaryInsertionSort(int arr[], int n) - отсортировать массив
 //
+// БЫСТРЫЙ ВАРИАНТ (для гибридных сортировок):
+//   void binary_insertion_sort_range(int arr[], int lo, int start, int hi)
+//     - arr[lo..start) уже отсортирован, дописываем в него arr[start..hi)
+//     - сдвиг одним memmove вместо поэлементного цикла
+//     - галоп от конца: на почти отсортированных данных O(1) сравнений
+//     - полная сортировка: binary_insertion_sort_range(arr, 0, 1, n)
+//
 // АЛГОРИТМ:
 //   1. Для каждого элемента, начиная со второго
 //   2. Используем бинарный поиск для нахождения позиции вставки 
@@ -21,6 +28,7 @@
 // ==========================================
 
 #include <stdio.h>
+#include <string.h>
 
 // Двоичная сортировка вставками
 void BinaryInsertionSort(int arr[], int n) {
@@ -31,10 +39,11 @@ void BinaryInsertionSort(int arr[], int n) {
     for (i = 1; i < n; i++) {
         x = arr[i];  // Элемент для вставки
         L = 0;       // Левая граница бинарного поиска
-        R = i - 1;   // Правая граница бинарного поиска
+        R = i;       // Правая граница (i - "за концом" отсортированной части)
         
         // ШАГ 1: БИНАРНЫЙ ПОИСК позиции для вставки
         // Ищем место, куда вставить x в отсортированной части [0, i-1]
+        // (R = i позволяет оставить x на месте, если он не меньше всех)
         // Цель: найти L, где все элементы левее L меньше или равны x
         while (L < R) {
             m = (L + R) / 2;  // Середина
@@ -60,6 +69,54 @@ void BinaryInsertionSort(int arr[], int n) {
     }
 }
 
+// Двоичная вставка на диапазоне с блочным сдвигом
+// arr[lo..start) - уже отсортированная часть (например, готовый run),
+// элементы arr[start..hi) по одному вставляются в неё.
+// Используется движками на слиянии для расширения коротких runs.
+void binary_insertion_sort_range(int arr[], int lo, int start, int hi) {
+    if (start <= lo) {
+        start = lo + 1;  // один элемент всегда отсортирован
+    }
+    
+    for (int i = start; i < hi; i++) {
+        int x = arr[i];
+        
+        // Элемент уже на месте - частый случай на почти отсортированных данных
+        if (arr[i - 1] <= x) {
+            continue;
+        }
+        
+        // ШАГ 1: ГАЛОП ОТ КОНЦА
+        // Известно, что arr[i-1] > x. Проверяем позиции i-1-1, i-1-2, i-1-4, ...
+        // пока не встретим элемент <= x. Так место вставки вблизи конца
+        // находится за O(log d) сравнений, где d - расстояние до него.
+        int R = i - 1;   // arr[R] > x
+        int ofs = 1;
+        int p = R - ofs;
+        while (p >= lo && arr[p] > x) {
+            R = p;
+            ofs *= 2;
+            p = i - 1 - ofs;
+        }
+        int L = (p < lo) ? lo : p + 1;  // arr[L-1] <= x (или L == lo)
+        
+        // ШАГ 2: БИНАРНЫЙ ПОИСК первого элемента > x в [L, R]
+        // Строгое сравнение сохраняет стабильность
+        while (L < R) {
+            int m = L + (R - L) / 2;
+            if (arr[m] <= x) {
+                L = m + 1;
+            } else {
+                R = m;
+            }
+        }
+        
+        // ШАГ 3: СДВИГ одним блоком и ВСТАВКА
+        memmove(&arr[L + 1], &arr[L], (size_t)(i - L) * sizeof(int));
+        arr[L] = x;
+    }
+}
+
 // ============ СЛОЖНОСТЬ ============
 // Время: O(n² log n) в худшем случае
 //        - Сравнений: O(n log n) благодаря бинарному поиску
@@ -76,6 +133,13 @@ void BinaryInsertionSort(int arr[], int n) {
 // - Стабильная сортировка
 // - Простая реализация
 
+// binary_insertion_sort_range:
+// - Сравнений: O(log d) на элемент, d - расстояние сдвига (галоп от конца)
+//   → O(n) на уже отсортированных и почти отсортированных данных
+// - Перемещений по-прежнему O(n²) в худшем случае, но это один memmove
+//   на элемент: копирование блоком в разы быстрее цикла arr[j] = arr[j-1]
+// - Это внутренний цикл TimSort и других гибридных сортировок
+
 // Когда использовать:
 // - Сравнения элементов очень дорогие
 // - Маленькие массивы (n < 50)
@@ -156,6 +220,23 @@ int main() {
         printf("%d ", arr4[i]);
     printf("\n\n");
     
+    // Тест 5: Расширение готового run (как в TimSort)
+    int arr5[] = {1, 3, 5, 7, 9, 11, 4, 12, 0, 10};
+    int n5 = sizeof(arr5) / sizeof(arr5[0]);
+    
+    printf("Тест 5: run [1..11] длины 6 + хвост, binary_insertion_sort_range\n");
+    printf("До:    ");
+    for (int i = 0; i < n5; i++)
+        printf("%d ", arr5[i]);
+    printf("\n");
+    
+    binary_insertion_sort_range(arr5, 0, 6, n5);
+    
+    printf("После: ");
+    for (int i = 0; i < n5; i++)
+        printf("%d ", arr5[i]);
+    printf("\n\n");
+    
     return 0;
 }
 */
@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 typedef struct {
     int* array;
@@ -7,111 +8,165 @@ typedef struct {
 } vector;
 
 /* ============================================================
-   ШПАРГАЛКА: Дек на двусвязном списке (Deque)
+   ШПАРГАЛКА: Дек на блоках (Deque, как std::deque)
    ============================================================
    typedef struct {
-       Item* left;   // левый конец дека
-       Item* right;  // правый конец дека
-       int size;     // размер дека
+       int** map;      // кольцо указателей на блоки по DEQUE_BLOCK чисел
+       int mapMask;    // размер кольца - 1 (размер - степень двойки)
+       int mapHead;    // ячейка map с первым блоком
+       int blocks;     // сколько блоков занято
+       int off;        // позиция левого элемента в первом блоке
+       int* spare;     // запасной блок для повторного использования
+       int size;       // размер дека
    } deque;
-   typedef struct Item {
-       int data;           // данные элемента
-       struct Item* next;  // следующий элемент
-       struct Item* prev;  // предыдущий элемент
-   } Item;
    ФУНКЦИИ:
    deque* CreateDeque(vector* v)         vector → Deque
    bool isEmptyDeque(deque* d)           Deque → boolean
+   int SizeDeque(deque* d)               Deque → N
    bool PushLeftDeque(deque* d, int i)   Deque × int → Deque
    bool PushRightDeque(deque* d, int i)  Deque × int → Deque
    bool PopLeftDeque(deque* d)           Deque → Deque
    bool PopRightDeque(deque* d)          Deque → Deque
    int TopLeftDeque(deque* d)            Deque → int
    int TopRightDeque(deque* d)           Deque → int
+   int AtDeque(deque* d, int i)          Deque × N → int
    bool DeleteDeque(deque* d)            Deque → ∅
-   ============================================================ */
+   ============================================================
+
+   Элементы лежат в блоках по DEQUE_BLOCK чисел, блоки - по порядку
+   в кольце map:
+
+     map:   [ . | B0 | B1 | B2 | . . . ]
+                 ↓    ↓    ↓
+               [. . x x][x x x x][x x . .]
+                    ↑off
+
+   - i-й элемент: позиция p = off + i, блок map[mapHead + p / DEQUE_BLOCK],
+     индекс в нём p % DEQUE_BLOCK - O(1), без обхода
+   - Push с любого конца пишет в крайний блок; новый блок нужен раз
+     на DEQUE_BLOCK операций. Блоки не переезжают: растёт только map
+     (указатели, в DEQUE_BLOCK раз меньше данных)
+   - Опустевший крайний блок становится запасным (spare): при скользящем
+     окне (push справа, pop слева) malloc/free не вызываются совсем
+   - Накладные расходы - ~8 / DEQUE_BLOCK байт на элемент вместо 20+
+     у узла двусвязного списка
+*/
 
-typedef struct Item{
-    int data;               // хранимое значение
-    struct Item * next;     // указатель на следующий элемент
-    struct Item * prev;     // указатель на предыдущий элемент
-} Item;
+// Чисел в блоке (степень двойки)
+#define DEQUE_BLOCK_SHIFT 8
+#define DEQUE_BLOCK (1 << DEQUE_BLOCK_SHIFT)
+
+// Начальный размер кольца map
+#define DEQUE_MAP_MIN 8
 
 typedef struct deque{
-    Item *left;   // указатель на левый конец дека
-    Item *right;  // указатель на правый конец дека
+    int **map;    // кольцо указателей на блоки
+    int mapMask;  // размер кольца - 1
+    int mapHead;  // ячейка map с первым блоком
+    int blocks;   // занято блоков
+    int off;      // позиция левого элемента в первом блоке
+    int *spare;   // запасной блок
     int size;     // размер дека
 } deque;
 
-// создание дека из вектора
-deque * CreateDeque(vector * v){
-    deque * d = (deque*)malloc(sizeof(deque));
-    d->size = 0;
-    d->left = 0;
-    d->right = 0;
-    
-    for(int i = 0; i < v->size; ++i)
-        PushLeftDeque(d, v->array[i]);
-    
-    return d;
+// ячейка map с k-м по порядку блоком
+static int **DequeSlot(deque *d, int k){
+    return &d->map[(d->mapHead + k) & d->mapMask];
+}
+
+// адрес элемента в позиции p = off + i
+static int *DequeCell(deque *d, int p){
+    return &(*DequeSlot(d, p >> DEQUE_BLOCK_SHIFT))[p & (DEQUE_BLOCK - 1)];
+}
+
+// взять запасной блок или выделить новый
+static int *DequeTakeBlock(deque *d){
+    int *b = d->spare;
+    if(b){
+        d->spare = NULL;
+        return b;
+    }
+    return (int*)malloc(sizeof(int) * DEQUE_BLOCK);
+}
+
+// вернуть опустевший блок: один оставляем про запас
+static void DequeReleaseBlock(deque *d, int *b){
+    if(d->spare)
+        free(d->spare);
+    d->spare = b;
+}
+
+// место в map ещё под один блок: кольцо растёт вдвое, блоки не копируются
+static bool DequeGrowMap(deque *d){
+    int cap = d->mapMask + 1;
+    if(d->blocks < cap)
+        return true;
+
+    int **map = (int**)malloc(sizeof(int*) * cap * 2);
+    if(!map)
+        return false;
+    for(int k = 0; k < d->blocks; ++k)
+        map[k] = *DequeSlot(d, k);
+    free(d->map);
+    d->map = map;
+    d->mapMask = cap * 2 - 1;
+    d->mapHead = 0;
+    return true;
 }
 
 // проверка отсутствия элементов в деке
 bool isEmptyDeque(deque *d){
     if(d->size == 0)
         return true;
-    
+
     return false;
 }
 
+// количество элементов
+int SizeDeque(deque *d){
+    return d->size;
+}
+
 // добавить элемент с левого конца
 bool PushLeftDeque(deque * d, int i){
-    Item *q = 0;
-    
-    if(d->left){
-        q = d->left;
-        d->left = d->left->prev;
+    if(d->off == 0){
+        // левый блок заполнен (или блоков нет) - новый блок слева
+        if(!DequeGrowMap(d))
+            return false;
+        int *b = DequeTakeBlock(d);
+        if(!b)
+            return false;
+        d->mapHead = (d->mapHead - 1) & d->mapMask;
+        d->map[d->mapHead] = b;
+        d->blocks++;
+        d->off = DEQUE_BLOCK;
     }
-    
-    d->left = (Item*)malloc(sizeof(Item));
-    d->left->data = i;
-    d->left->next = q;
-    
-    if(d->left->next)
-        d->left->next->prev=d->left;
-    
-    d->left->prev = 0;
-    
-    if(!q)
-        d->right=d->left;
-    
+
+    d->off--;
+    *DequeCell(d, d->off) = i;
     d->size++;
-    
+
     return true;
 }
 
 // добавить элемент с правого конца
 bool PushRightDeque(deque * d, int i){
-    Item *q = 0;
-    
-    if(d->right!=0){
-        q = d->right;
-        d->right = d->right->next;
+    int p = d->off + d->size;
+
+    if((p >> DEQUE_BLOCK_SHIFT) == d->blocks){
+        // правый блок заполнен (или блоков нет) - новый блок справа
+        if(!DequeGrowMap(d))
+            return false;
+        int *b = DequeTakeBlock(d);
+        if(!b)
+            return false;
+        *DequeSlot(d, d->blocks) = b;
+        d->blocks++;
     }
-    
-    d->right = (Item*)malloc(sizeof(Item));
-    d->right->data = i;
-    d->right->next = 0;
-    d->right->prev = q;
-    
-    if(d->right->prev)
-        d->right->prev->next=d->right;
-    
-    if(!q)
-        d->left=d->right;
-    
+
+    *DequeCell(d, p) = i;
     d->size++;
-    
+
     return true;
 }
 
@@ -119,20 +174,18 @@ bool PushRightDeque(deque * d, int i){
 bool PopLeftDeque(deque * d){
     if(isEmptyDeque(d))
         return false;
-    
-    Item *q;
-    q = d->left->next;
-    free(d->left);
+
+    d->off++;
     d->size--;
-    d->left = q;
-    
-    if(d->size == 0){
-        d->right = d->left;
-        return true;
+
+    if(d->off == DEQUE_BLOCK){
+        // первый блок опустел
+        DequeReleaseBlock(d, d->map[d->mapHead]);
+        d->mapHead = (d->mapHead + 1) & d->mapMask;
+        d->blocks--;
+        d->off = 0;
     }
-    
-    d->left->prev = 0;
-    
+
     return true;
 }
 
@@ -140,99 +193,206 @@ bool PopLeftDeque(deque * d){
 bool PopRightDeque(deque * d){
     if(isEmptyDeque(d))
         return false;
-    
-    Item *q;
-    q = d->right->prev;
-    free(d->right);
+
     d->size--;
-    d->right=q;
-    
-    if(d->size == 0){
-        d->left = d->right;
-        return true;
+
+    if(d->off + d->size == (d->blocks - 1) * DEQUE_BLOCK){
+        // последний блок опустел
+        d->blocks--;
+        DequeReleaseBlock(d, *DequeSlot(d, d->blocks));
+        if(d->blocks == 0)
+            d->off = 0;
     }
-    d->right->next = 0;
-    
+
     return true;
 }
 
 // посмотреть элемент с левого конца
 int TopLeftDeque(deque * d){
     if(isEmptyDeque(d))
-        return 0; // ошибка, обращение к нулевому указателю
-    
-    return d->left->data;
+        return 0; // ошибка, дек пуст
+
+    return *DequeCell(d, d->off);
 }
 
 // посмотреть элемент с правого конца
 int TopRightDeque(deque * d){
     if(isEmptyDeque(d))
-        return 0; // ошибка, обращение к нулевому указателю
-    
-    return d->right->data;
+        return 0; // ошибка, дек пуст
+
+    return *DequeCell(d, d->off + d->size - 1);
+}
+
+// i-й элемент слева (0 - левый конец)
+int AtDeque(deque * d, int i){
+    if(i < 0 || i >= d->size)
+        return 0; // ошибка, выход за границы
+
+    return *DequeCell(d, d->off + i);
+}
+
+bool DeleteDeque(deque * d);
+
+// создание дека из вектора
+// как и n вызовов PushLeftDeque: v[0] оказывается справа, v[n-1] - слева,
+// но блоки выделяются сразу и заполняются подряд
+deque * CreateDeque(vector * v){
+    deque * d = (deque*)malloc(sizeof(deque));
+    if(!d)
+        return NULL;
+    memset(d, 0, sizeof(deque));
+
+    int n = v->size;
+    int blocks = (n + DEQUE_BLOCK - 1) / DEQUE_BLOCK;
+    int cap = DEQUE_MAP_MIN;
+    while(cap < blocks)
+        cap *= 2;
+    d->map = (int**)malloc(sizeof(int*) * cap);
+    if(!d->map){
+        free(d);
+        return NULL;
+    }
+    d->mapMask = cap - 1;
+
+    // свободное место - в начале первого блока, как после серии PushLeft
+    d->off = blocks * DEQUE_BLOCK - n;
+    for(int k = 0; k < blocks; ++k){
+        d->map[k] = (int*)malloc(sizeof(int) * DEQUE_BLOCK);
+        if(!d->map[k]){
+            d->blocks = k;
+            DeleteDeque(d);
+            return NULL;
+        }
+        d->blocks++;
+    }
+    for(int i = 0; i < n; ++i)
+        *DequeCell(d, d->off + i) = v->array[n - 1 - i];
+    d->size = n;
+
+    return d;
 }
 
 // удалить дек
 bool DeleteDeque(deque * d){
-    while(!isEmptyDeque(d)){
-        Item *q = d->left->next;
-        free(d->left);
-        d->left = q;
-        d->size--;
-    }
-    d->left = d->right = NULL;
+    for(int k = 0; k < d->blocks; ++k)
+        free(*DequeSlot(d, k));
+    free(d->spare);
+    free(d->map);
+    free(d);
     return true;
 }
 
 // ============ СЛОЖНОСТЬ ============
-// CreateDeque: O(n) - создание из вектора
-// PushLeft/PushRight: O(1) - добавление с любого конца
+// CreateDeque: O(n) - блоки выделяются сразу, без поэлементных malloc
+// PushLeft/PushRight: O(1) амортизированное - malloc раз на DEQUE_BLOCK
+//                     операций, map растёт вдвое (копируются указатели)
 // PopLeft/PopRight: O(1) - удаление с любого конца
 // TopLeft/TopRight: O(1) - просмотр без удаления
-// isEmptyDeque: O(1) - проверка пустоты
-// DeleteDeque: O(n) - удаление всех элементов
-// Память: O(n) - двусвязный список
+// AtDeque: O(1) - произвольный доступ по индексу
+// isEmptyDeque / SizeDeque: O(1)
+// DeleteDeque: O(n / DEQUE_BLOCK) - освобождение блоков
+// Память: O(n) - ~4 байта на элемент + не больше двух неполных блоков
 
 // ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
 
 /*
 #include <stdio.h>
+#include <time.h>
+
+// Узел прежней реализации - для сравнения в тесте 5
+typedef struct ItemOld {
+    int data;
+    struct ItemOld* next;
+    struct ItemOld* prev;
+} ItemOld;
 
 int main() {
-    printf("=== Дек (Deque) на двусвязном списке ===\n\n");
-    
+    printf("=== Дек (Deque) на блоках ===\n\n");
+
+    vector empty = {NULL, 0};
+
     // Тест 1: Добавление с левого конца
-    deque* d1 = (deque*)malloc(sizeof(deque));
-    d1->size = 0; d1->left = d1->right = NULL;
-    
+    deque* d1 = CreateDeque(&empty);
+
     printf("Тест 1: PushLeft\n");
     PushLeftDeque(d1, 10);
     PushLeftDeque(d1, 20);
     PushLeftDeque(d1, 30);
-    printf("После PushLeft(10,20,30): Left=%d, Right=%d, Size=%d\n", 
-           TopLeftDeque(d1), TopRightDeque(d1), d1->size); // Left=30, Right=10, Size=3
-    
+    printf("После PushLeft(10,20,30): Left=%d, Right=%d, Size=%d\n",
+           TopLeftDeque(d1), TopRightDeque(d1), SizeDeque(d1)); // Left=30, Right=10, Size=3
+
     // Тест 2: Добавление с правого конца
-    deque* d2 = (deque*)malloc(sizeof(deque));
-    d2->size = 0; d2->left = d2->right = NULL;
-    
+    deque* d2 = CreateDeque(&empty);
+
     printf("\nТест 2: PushRight\n");
     PushRightDeque(d2, 1);
     PushRightDeque(d2, 2);
     PushRightDeque(d2, 3);
-    printf("После PushRight(1,2,3): Left=%d, Right=%d, Size=%d\n", 
-           TopLeftDeque(d2), TopRightDeque(d2), d2->size); // Left=1, Right=3, Size=3
-    
+    printf("После PushRight(1,2,3): Left=%d, Right=%d, Size=%d\n",
+           TopLeftDeque(d2), TopRightDeque(d2), SizeDeque(d2)); // Left=1, Right=3, Size=3
+
     // Тест 3: Удаление с обоих концов
     printf("\nТест 3: PopLeft и PopRight\n");
     PopLeftDeque(d1);  // Удаляем 30
     PopRightDeque(d1); // Удаляем 10
-    printf("После Pop: Left=%d, Right=%d, Size=%d\n", 
-           TopLeftDeque(d1), TopRightDeque(d1), d1->size); // Left=20, Right=20, Size=1
-    
+    printf("После Pop: Left=%d, Right=%d, Size=%d\n",
+           TopLeftDeque(d1), TopRightDeque(d1), SizeDeque(d1)); // Left=20, Right=20, Size=1
+
+    // Тест 4: Создание из вектора и доступ по индексу
+    int n = 1000;
+    vector v = {malloc(sizeof(int) * n), n};
+    for (int i = 0; i < n; i++) v.array[i] = i;
+    deque* d3 = CreateDeque(&v);
+    for (int i = 0; i < 600; i++) PushLeftDeque(d3, -1 - i);  // блоки слева
+    printf("\nТест 4: CreateDeque(0..999) + 600 PushLeft\n");
+    printf("Size=%d, d[0]=%d, d[600]=%d, d[1599]=%d\n", SizeDeque(d3),
+           AtDeque(d3, 0), AtDeque(d3, 600), AtDeque(d3, 1599)); // 1600, -600, 999, 0
+
+    // Тест 5: Скользящее окно - блоки против узла на элемент
+    int ops = 50000000, window = 1000;
+    clock_t t0 = clock();
+    ItemOld* left = NULL;
+    ItemOld* right = NULL;
+    int oldSize = 0;
+    long long sumOld = 0;
+    for (int i = 0; i < ops; i++) {
+        ItemOld* it = malloc(sizeof(ItemOld));  // старый вариант: malloc на элемент
+        it->data = i; it->next = NULL; it->prev = right;
+        if (right) right->next = it; else left = it;
+        right = it;
+        if (++oldSize > window) {
+            ItemOld* f = left;
+            sumOld += f->data;
+            left = f->next; left->prev = NULL;
+            free(f);
+            oldSize--;
+        }
+    }
+    while (left) { ItemOld* f = left; left = left->next; free(f); }
+    double tList = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    deque* d4 = CreateDeque(&empty);
+    long long sumNew = 0;
+    t0 = clock();
+    for (int i = 0; i < ops; i++) {
+        PushRightDeque(d4, i);
+        if (SizeDeque(d4) > window) {
+            sumNew += TopLeftDeque(d4);
+            PopLeftDeque(d4);
+        }
+    }
+    double tBlocks = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    printf("\nТест 5: окно %d, %d операций\n", window, ops);
+    printf("узел на элемент: %.3f с\n", tList);
+    printf("блоки по %d:     %.3f с, суммы совпали? %s\n", DEQUE_BLOCK, tBlocks,
+           sumOld == sumNew ? "Да" : "Нет");
+
     DeleteDeque(d1);
     DeleteDeque(d2);
-    
+    DeleteDeque(d3);
+    DeleteDeque(d4);
+    free(v.array);
+
     return 0;
 }
 */
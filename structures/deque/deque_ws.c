@@ -0,0 +1,255 @@
+// Дек для перехвата работы (work-stealing deque) без блокировок
+// Алгоритм Чейза - Лева: владелец работает с нижним концом как со стеком,
+// остальные потоки ("воры") забирают элементы с верхнего конца
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "deque_ws.h"
+
+/* ============================================================
+   ШПАРГАЛКА: Дек Чейза - Лева (Deque WS)
+   ============================================================
+   typedef struct WSBuffer {
+       long long mask;          // вместимость - 1 (вместимость - 2^k)
+       struct WSBuffer* prev;   // предыдущий (меньший) буфер
+       _Atomic(T) data[];       // кольцевой буфер
+   } WSBuffer;
+   typedef struct {
+       atomic_llong top;            // верх: отсюда крадут (своя строка кэша)
+       atomic_llong bottom;         // низ: здесь работает владелец
+       _Atomic(WSBuffer*) buffer;   // текущий буфер
+   } DequeWS;
+   ФУНКЦИИ:
+   bool WS_Create(DequeWS* d, long long capacity)  N → Deque
+   void WS_Destroy(DequeWS* d)                     Deque → ∅
+   long long WS_Size(DequeWS* d)                   Deque → N
+   bool WS_Push(DequeWS* d, T t)       владелец    Deque × T → Deque
+   bool WS_Pop(DequeWS* d, T* out)     владелец    Deque → Deque × T
+   bool WS_Steal(DequeWS* d, T* out)   любой поток Deque → Deque × T
+   ============================================================
+
+   РАСКЛАДКА (top и bottom только растут, индекс в буфере - i & mask):
+
+     top                      bottom
+      ↓                         ↓
+     [ t0 | t1 | t2 | t3 | t4 ]
+      ↑ Steal забирает          ↑ Push кладёт, Pop забирает
+        самый старый              самый новый
+
+   - Владелец (один поток) - Push/Pop с низа, как со стеком: новые
+     задачи горячие в кэше, и обычно он ни с кем не конкурирует
+   - Воры - Steal с верха: самые старые задачи, обычно самые крупные
+     (при делении пополам - половина всей оставшейся работы)
+   - Конфликт возможен только за последний элемент: Pop и Steal
+     решают его одним CAS на top
+   - Буфер полон → владелец копирует элементы в буфер вдвое больше.
+     Старый буфер не освобождается до WS_Destroy: вор мог успеть
+     прочитать указатель на него (память - не больше 2 × итоговой)
+
+   ПОРЯДОК ПАМЯТИ (Lê, Pop, Cohen, Zappa Nardelli, 2013):
+     Push:  data[b] = t; bottom = b + 1 (release)
+     Pop:   bottom = b - 1; барьер seq_cst; читаем top
+     Steal: читаем top; барьер seq_cst; читаем bottom (acquire)
+     Барьеры в Pop и Steal не дают обоим считать, что последний
+     элемент достался им: один из них увидит изменение другого
+*/
+
+static WSBuffer* wsNewBuffer(long long capacity, WSBuffer* prev) {
+    WSBuffer* buf = malloc(sizeof(WSBuffer) + sizeof(_Atomic(T)) * (size_t)capacity);
+    if (!buf) return NULL;
+    buf->mask = capacity - 1;
+    buf->prev = prev;
+    return buf;
+}
+
+// Вместимость округляется вверх до степени двойки
+bool WS_Create(DequeWS* d, long long capacity) {
+    long long cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    WSBuffer* buf = wsNewBuffer(cap, NULL);
+    if (!buf) return false;
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    atomic_init(&d->buffer, buf);
+    return true;
+}
+
+// Вызывать, когда с деком уже никто не работает
+void WS_Destroy(DequeWS* d) {
+    WSBuffer* buf = atomic_load_explicit(&d->buffer, memory_order_relaxed);
+    while (buf) {
+        WSBuffer* prev = buf->prev;
+        free(buf);
+        buf = prev;
+    }
+    atomic_store_explicit(&d->buffer, NULL, memory_order_relaxed);
+}
+
+// Приблизительный размер (мгновенный снимок)
+long long WS_Size(DequeWS* d) {
+    long long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    return (b > t) ? b - t : 0;
+}
+
+// Буфер вдвое больше с элементами [t, b) на тех же индексах
+static WSBuffer* wsGrow(DequeWS* d, WSBuffer* old, long long t, long long b) {
+    WSBuffer* buf = wsNewBuffer((old->mask + 1) * 2, old);
+    if (!buf) return NULL;
+    for (long long i = t; i < b; i++) {
+        T x = atomic_load_explicit(&old->data[i & old->mask], memory_order_relaxed);
+        atomic_store_explicit(&buf->data[i & buf->mask], x, memory_order_relaxed);
+    }
+    // release: вор, прочитавший новый указатель, видит скопированное
+    atomic_store_explicit(&d->buffer, buf, memory_order_release);
+    return buf;
+}
+
+// Положить на низ (только владелец); false - не хватило памяти
+bool WS_Push(DequeWS* d, T t) {
+    long long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&d->top, memory_order_acquire);
+    WSBuffer* buf = atomic_load_explicit(&d->buffer, memory_order_relaxed);
+    if (b - top > buf->mask) {
+        buf = wsGrow(d, buf, top, b);
+        if (!buf) return false;
+    }
+    atomic_store_explicit(&buf->data[b & buf->mask], t, memory_order_relaxed);
+    // release: вор, увидевший новый bottom, видит и элемент
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_release);
+    return true;
+}
+
+// Забрать с низа (только владелец); false - дек пуст
+bool WS_Pop(DequeWS* d, T* out) {
+    long long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    WSBuffer* buf = atomic_load_explicit(&d->buffer, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        // Пуст: возвращаем bottom на место
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    *out = atomic_load_explicit(&buf->data[b & buf->mask], memory_order_relaxed);
+    if (t < b) {
+        return true;  // элементов больше одного - воры до этого не дотянутся
+    }
+
+    // Последний элемент: соревнуемся с ворами за top
+    bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                   memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return won;
+}
+
+// Украсть с верха (любой поток)
+// false - дек пуст или элемент забрал другой поток (можно повторить)
+bool WS_Steal(DequeWS* d, T* out) {
+    long long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) {
+        return false;
+    }
+
+    WSBuffer* buf = atomic_load_explicit(&d->buffer, memory_order_acquire);
+    T x = atomic_load_explicit(&buf->data[t & buf->mask], memory_order_relaxed);
+    // CAS подтверждает, что элемент t никто не забрал раньше нас
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+            memory_order_seq_cst, memory_order_relaxed)) {
+        return false;
+    }
+    *out = x;
+    return true;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// WS_Push: O(1) амортизированное - рост буфера вдвое копирует O(n)
+// WS_Pop: O(1) - без атомарных RMW, кроме спора за последний элемент
+// WS_Steal: O(1) - один CAS; при конкуренции воров может не удаться
+//           (lock-free: неудача одного - успех другого)
+// WS_Size: O(1) - приблизительно
+// Память: O(n) - буферы 2^k, старые хранятся до WS_Destroy
+//
+// Сравнение с деком под мьютексом:
+// - Владелец почти всегда работает без RMW-операций: Push - две записи,
+//   Pop - запись, барьер и чтение
+// - Воры конкурируют только между собой и только за top
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define ITEMS 2000000L
+#define THIEVES 3
+
+DequeWS wd;
+atomic_bool ownerDone;
+
+// Вор: крадёт, пока владелец не закончил и дек не опустел
+void* thief(void* arg) {
+    long long* sum = arg;
+    T t;
+    while (!atomic_load(&ownerDone) || WS_Size(&wd) > 0) {
+        if (WS_Steal(&wd, &t)) *sum += (long)t;
+        else sched_yield();
+    }
+    return NULL;
+}
+
+int main() {
+    printf("=== Дек Чейза - Лева ===\n\n");
+
+    // Тест 1: Владелец - стек, вор - очередь
+    DequeWS d;
+    WS_Create(&d, 4);
+    for (long i = 1; i <= 5; i++) WS_Push(&d, (void*)i);  // рост 4 → 8
+    T a, b, c;
+    WS_Pop(&d, &a);
+    WS_Steal(&d, &b);
+    WS_Steal(&d, &c);
+    printf("Тест 1: Pop=%ld, Steal=%ld, Steal=%ld, осталось %lld\n",
+           (long)a, (long)b, (long)c, WS_Size(&d)); // 5, 1, 2, 2
+    while (WS_Pop(&d, &a)) {}
+    printf("После опустошения: Pop %s\n", WS_Pop(&d, &a) ? "удался" : "пуст"); // пуст
+    WS_Destroy(&d);
+
+    // Тест 2: Владелец кладёт и забирает, воры крадут - каждый элемент
+    // достаётся ровно одному потоку
+    WS_Create(&wd, WS_MIN_CAPACITY);
+    pthread_t th[THIEVES];
+    long long stolen[THIEVES] = {0};
+    for (int i = 0; i < THIEVES; i++) pthread_create(&th[i], NULL, thief, &stolen[i]);
+
+    long long sum = 0;
+    T t;
+    for (long i = 1; i <= ITEMS; i++) {
+        WS_Push(&wd, (void*)i);
+        if (i % 3 == 0 && WS_Pop(&wd, &t)) sum += (long)t;
+    }
+    while (WS_Pop(&wd, &t)) sum += (long)t;
+    atomic_store(&ownerDone, true);
+
+    long long total = sum;
+    for (int i = 0; i < THIEVES; i++) {
+        pthread_join(th[i], NULL);
+        total += stolen[i];
+    }
+    printf("\nТест 2: %ld элементов, %d вора\n", ITEMS, THIEVES);
+    printf("Сумма сошлась? %s, ворам досталось %.1f%%\n",
+           total == ITEMS * (ITEMS + 1) / 2 ? "Да" : "Нет",
+           100.0 * (total - sum) / total); // Да
+    WS_Destroy(&wd);
+
+    return 0;
+}
+*/
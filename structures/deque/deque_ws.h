@@ -0,0 +1,42 @@
+// Дек Чейза - Лева для перехвата работы (work-stealing deque)
+// Объявления для других единиц трансляции (fork_join.c);
+// реализация и шпаргалка - в deque_ws.c, собирать вместе с ним
+
+#ifndef DEQUE_WS_H
+#define DEQUE_WS_H
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+typedef void* T;
+
+#define CACHE_LINE 64
+
+// Начальная вместимость по умолчанию
+#define WS_MIN_CAPACITY 64
+
+typedef struct WSBuffer {
+    long long mask;
+    struct WSBuffer* prev;
+    _Atomic(T) data[];
+} WSBuffer;
+
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_llong top;
+    _Alignas(CACHE_LINE) atomic_llong bottom;
+    _Atomic(WSBuffer*) buffer;
+} DequeWS;
+
+// Вместимость округляется вверх до степени двойки
+bool WS_Create(DequeWS* d, long long capacity);
+// Вызывать, когда с деком уже никто не работает
+void WS_Destroy(DequeWS* d);
+// Приблизительный размер (мгновенный снимок)
+long long WS_Size(DequeWS* d);
+// Только владелец: положить / забрать с низа
+bool WS_Push(DequeWS* d, T t);
+bool WS_Pop(DequeWS* d, T* out);
+// Любой поток: забрать самый старый элемент с верха
+bool WS_Steal(DequeWS* d, T* out);
+
+#endif // DEQUE_WS_H
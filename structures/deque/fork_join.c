@@ -0,0 +1,407 @@
+// Планировщик fork-join с перехватом работы (work stealing)
+// Пул потоков поверх деков Чейза - Лева (deque_ws.c): у каждого потока
+// свой дек задач, простаивающий поток крадёт задачи у других
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "deque_ws.h"  // реализация - deque_ws.c, собирать вместе с ним
+
+/* ============================================================
+   ШПАРГАЛКА: Пул fork-join (ForkJoinPool)
+   ============================================================
+   typedef struct FJTask {
+       void (*fn)(void* arg);   // что выполнить
+       void* arg;
+       atomic_int done;         // 1 - выполнена
+   } FJTask;
+   typedef struct {
+       struct FJWorker* workers;   // workers[0] - поток, вызвавший FJ_Run
+       int count;                  // потоков всего
+       atomic_bool stop;           // FJ_Destroy: завершить потоки
+       atomic_uint event;          // счётчик событий для сна (futex)
+   } ForkJoinPool;
+   ФУНКЦИИ:
+   bool FJ_Create(ForkJoinPool* p, int threads)   N → Pool (0 - по числу ядер)
+   void FJ_Destroy(ForkJoinPool* p)               Pool → ∅
+   void FJ_Run(ForkJoinPool* p, void (*fn)(void*), void* arg)
+                                                  выполнить корневую задачу
+   void FJ_Fork(FJTask* t, void (*fn)(void*), void* arg)
+                                                  запустить подзадачу
+   void FJ_Join(FJTask* t)                        дождаться подзадачи
+   ============================================================
+
+   ИСПОЛЬЗОВАНИЕ (внутри задачи, FJTask - на стеке, без malloc):
+     FJTask left;
+     FJ_Fork(&left, sortPart, &leftRange);   // левая половина - в дек
+     sortPart(&rightRange);                  // правую делаем сами
+     FJ_Join(&left);                         // левую: сами или вор
+
+   КАК РАБОТАЕТ:
+   - FJ_Fork кладёт задачу на низ своего дека (WS_Push) - быстро,
+     без блокировок и системных вызовов
+   - FJ_Join: пока задача не готова - берём задачи со своего дека
+     (обычно это она сама - тогда выполняем её без всякой
+     синхронизации), иначе крадём у других: поток не простаивает
+   - Свободный поток крадёт с ВЕРХА чужого дека самую старую задачу -
+     при делении пополам это самый крупный кусок работы, поэтому
+     кражи редки: O(потоков × глубина рекурсии), а не O(задач)
+   - Нечего красть → короткое ожидание, затем сон на futex (счётчик
+     событий, как в queue_mpmc.c); FJ_Fork будит спящих, только если
+     они есть
+
+   ОГРАНИЧЕНИЯ:
+   - Одновременно - один FJ_Run на пул (вызывающий поток становится
+     потоком 0 на время FJ_Run)
+   - FJ_Fork/FJ_Join вне FJ_Run выполняют задачу сразу в текущем потоке
+   - Каждую FJ_Fork нужно закрыть FJ_Join до выхода из функции
+     (FJTask живёт на её стеке)
+*/
+
+// Сколько раз попытаться украсть, прежде чем заснуть
+// (вторую половину попыток - уступая процессор)
+#define FJ_SPIN 64
+
+typedef struct FJTask {
+    void (*fn)(void* arg);
+    void* arg;
+    atomic_int done;
+} FJTask;
+
+typedef struct ForkJoinPool ForkJoinPool;
+
+typedef struct FJWorker {
+    DequeWS deque;
+    ForkJoinPool* pool;
+    int index;
+    unsigned seed;       // выбор жертвы для кражи
+    pthread_t thread;
+} FJWorker;
+
+struct ForkJoinPool {
+    FJWorker* workers;
+    int count;
+    atomic_bool stop;
+    _Alignas(CACHE_LINE) atomic_uint event;  // бит 0 - есть спящие
+};
+
+// Поток пула, в котором мы сейчас выполняемся (NULL - вне пула)
+static _Thread_local FJWorker* fjSelf = NULL;
+
+// ============ СОН И ПРОБУЖДЕНИЕ ============
+
+static void fjFutexWait(atomic_uint* event, unsigned expected) {
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned*)event, FUTEX_WAIT_PRIVATE, expected,
+            NULL, NULL, 0);
+#else
+    (void)event; (void)expected;
+    sched_yield();
+#endif
+}
+
+static void fjFutexWakeAll(atomic_uint* event) {
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned*)event, FUTEX_WAKE_PRIVATE, INT32_MAX,
+            NULL, NULL, 0);
+#else
+    (void)event;
+#endif
+}
+
+// Взвести бит "есть спящие"; возвращает значение, на котором спать
+static unsigned fjPrepareWait(ForkJoinPool* p) {
+    unsigned ev = atomic_load_explicit(&p->event, memory_order_relaxed);
+    while (!(ev & 1) &&
+           !atomic_compare_exchange_weak_explicit(&p->event, &ev, ev | 1,
+               memory_order_seq_cst, memory_order_relaxed)) {
+    }
+    atomic_thread_fence(memory_order_seq_cst);
+    return ev | 1;
+}
+
+// Разбудить спящих, если такие есть
+static void fjNotify(ForkJoinPool* p) {
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned ev = atomic_load_explicit(&p->event, memory_order_relaxed);
+    if ((ev & 1) &&
+        atomic_compare_exchange_strong_explicit(&p->event, &ev, ev + 1,
+            memory_order_relaxed, memory_order_relaxed)) {
+        fjFutexWakeAll(&p->event);
+    }
+}
+
+// ============ ВЫПОЛНЕНИЕ ============
+
+static void fjExecute(FJTask* t) {
+    t->fn(t->arg);
+    // release: ждущий в FJ_Join видит всё, что записала задача
+    atomic_store_explicit(&t->done, 1, memory_order_release);
+}
+
+// Украсть задачу у кого-нибудь, начиная со случайного потока
+static bool fjSteal(FJWorker* w, FJTask** out) {
+    int n = w->pool->count;
+    w->seed = w->seed * 1103515245u + 12345u;
+    int start = (int)((w->seed >> 16) % (unsigned)n);
+    for (int k = 0; k < n; k++) {
+        FJWorker* victim = &w->pool->workers[(start + k) % n];
+        if (victim != w && WS_Steal(&victim->deque, (T*)out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Найти задачу: сначала свой дек, потом чужие
+static bool fjFind(FJWorker* w, FJTask** out) {
+    return WS_Pop(&w->deque, (T*)out) || fjSteal(w, out);
+}
+
+static void* fjWorkerMain(void* arg) {
+    FJWorker* w = arg;
+    ForkJoinPool* p = w->pool;
+    fjSelf = w;
+    FJTask* t;
+    while (!atomic_load_explicit(&p->stop, memory_order_acquire)) {
+        bool found = false;
+        for (int i = 0; i < FJ_SPIN && !found; i++) {
+            found = fjFind(w, &t);
+            if (!found && i >= FJ_SPIN / 2) sched_yield();
+        }
+        if (found) {
+            fjExecute(t);
+            continue;
+        }
+        // Взводим бит ДО последней попытки - иначе можно пропустить
+        // задачу, появившуюся между попыткой и сном
+        unsigned ev = fjPrepareWait(p);
+        if (fjFind(w, &t)) {
+            fjExecute(t);
+        } else if (!atomic_load_explicit(&p->stop, memory_order_acquire)) {
+            fjFutexWait(&p->event, ev);
+        }
+    }
+    return NULL;
+}
+
+// ============ ОСНОВНЫЕ ФУНКЦИИ ============
+
+// Остановить потоки 1..started-1, разобрать деки 0..deques-1 и обнулить p
+// Общая часть FJ_Destroy и отката неудачного FJ_Create
+static void fjTeardown(ForkJoinPool* p, int started, int deques) {
+    atomic_store_explicit(&p->stop, true, memory_order_release);
+    // Меняем счётчик без условия: спящий либо уже спит (разбудим),
+    // либо ещё не заснул и увидит другое значение event
+    atomic_fetch_add_explicit(&p->event, 2, memory_order_seq_cst);
+    fjFutexWakeAll(&p->event);
+    for (int i = 1; i < started; i++) {
+        pthread_join(p->workers[i].thread, NULL);
+    }
+    for (int i = 0; i < deques; i++) {
+        WS_Destroy(&p->workers[i].deque);
+    }
+    free(p->workers);
+    memset(p, 0, sizeof(*p));
+}
+
+// threads - всего потоков, включая вызывающий FJ_Run (0 - по числу ядер)
+// false - не хватило памяти или потоков; всё уже созданное разобрано,
+// p обнулён (FJ_Destroy для него ничего не делает)
+bool FJ_Create(ForkJoinPool* p, int threads) {
+    memset(p, 0, sizeof(*p));
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (int)cpus : 1;
+    }
+    // Дек выровнен по строке кэша - malloc этого не гарантирует
+    p->workers = aligned_alloc(_Alignof(FJWorker), sizeof(FJWorker) * (size_t)threads);
+    if (!p->workers) return false;
+    memset(p->workers, 0, sizeof(FJWorker) * (size_t)threads);
+    p->count = threads;
+    atomic_init(&p->stop, false);
+    atomic_init(&p->event, 0);
+
+    // Все деки - до первого потока: потоки крадут из любого дека пула
+    for (int i = 0; i < threads; i++) {
+        FJWorker* w = &p->workers[i];
+        w->pool = p;
+        w->index = i;
+        w->seed = 0x9e3779b9u * (unsigned)(i + 1);
+        if (!WS_Create(&w->deque, WS_MIN_CAPACITY)) {
+            fjTeardown(p, 0, i);
+            return false;
+        }
+    }
+    // Поток 0 - вызывающий FJ_Run, остальные запускаем
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&p->workers[i].thread, NULL, fjWorkerMain, &p->workers[i]) != 0) {
+            fjTeardown(p, i, threads);  // уже запущенные - остановить
+            return false;
+        }
+    }
+    return true;
+}
+
+void FJ_Destroy(ForkJoinPool* p) {
+    fjTeardown(p, p->count, p->count);
+}
+
+// Запустить подзадачу: fn(arg) выполнится в этом или другом потоке
+void FJ_Fork(FJTask* t, void (*fn)(void*), void* arg) {
+    t->fn = fn;
+    t->arg = arg;
+    atomic_init(&t->done, 0);
+    FJWorker* w = fjSelf;
+    if (!w || !WS_Push(&w->deque, t)) {
+        fjExecute(t);  // вне пула (или нет памяти) - сразу здесь
+        return;
+    }
+    fjNotify(w->pool);
+}
+
+// Дождаться подзадачи, выполняя пока другие задачи
+void FJ_Join(FJTask* t) {
+    FJWorker* w = fjSelf;
+    FJTask* other;
+    while (!atomic_load_explicit(&t->done, memory_order_acquire)) {
+        if (w && fjFind(w, &other)) {
+            fjExecute(other);  // чаще всего other == t: её никто не украл
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+// Выполнить fn(arg) в пуле; вызывающий поток работает как поток 0
+// Возвращает управление, когда fn и все её подзадачи завершены
+void FJ_Run(ForkJoinPool* p, void (*fn)(void*), void* arg) {
+    FJWorker* saved = fjSelf;
+    fjSelf = &p->workers[0];
+    fn(arg);
+    fjSelf = saved;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// FJ_Fork: O(1) - WS_Push и проверка "есть ли спящие"
+// FJ_Join: O(1), если задачу никто не украл (WS_Pop); иначе ждёт,
+//          выполняя чужие задачи
+// Кражи: O(P · D) для P потоков и глубины рекурсии D - крадётся
+//        самая крупная из оставшихся задач
+// Время алгоритма "разделяй и властвуй": T₁/P + O(T∞) (Blumofe, Leiserson),
+// T₁ - работа, T∞ - длина критического пути
+// Память: O(D) задач на поток - FJTask живут на стеках
+//
+// Пул выгоднее "поток на подзадачу": потоки создаются один раз,
+// а Fork/Join без кражи стоят как пара обращений к памяти
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "deque_ws.c"
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Числа Фибоначчи - много мелких задач
+typedef struct { int n; long result; } Fib;
+
+void fib(void* arg) {
+    Fib* f = arg;
+    if (f->n < 2) { f->result = f->n; return; }
+    Fib a = {f->n - 1, 0}, b = {f->n - 2, 0};
+    FJTask t;
+    FJ_Fork(&t, fib, &a);
+    fib(&b);
+    FJ_Join(&t);
+    f->result = a.result + b.result;
+}
+
+// Параллельная быстрая сортировка: левую часть - в дек, правую - сами
+typedef struct { int* a; long n; } Range;
+
+#define SORT_CUTOFF 4096
+
+static int cmpInt(const void* x, const void* y) {
+    int a = *(const int*)x, b = *(const int*)y;
+    return (a > b) - (a < b);
+}
+
+void psort(void* arg) {
+    Range* r = arg;
+    int* a = r->a;
+    long n = r->n;
+    if (n <= SORT_CUTOFF) { qsort(a, n, sizeof(int), cmpInt); return; }
+    int pivot = a[n / 2];
+    long i = 0, j = n - 1;
+    while (i <= j) {  // разбиение Хоара, как в hoar_rec.c
+        while (a[i] < pivot) i++;
+        while (a[j] > pivot) j--;
+        if (i <= j) { int t = a[i]; a[i] = a[j]; a[j] = t; i++; j--; }
+    }
+    Range left = {a, j + 1}, right = {a + i, n - i};
+    FJTask t;
+    FJ_Fork(&t, psort, &left);
+    psort(&right);
+    FJ_Join(&t);
+}
+
+int main() {
+    printf("=== Пул fork-join ===\n\n");
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Тест 1: fib(27) - ~600 тыс. задач
+    ForkJoinPool pool;
+    FJ_Create(&pool, 4);
+    Fib f = {27, 0};
+    double t0 = now();
+    FJ_Run(&pool, fib, &f);
+    printf("Тест 1: fib(27) = %ld за %.3f с (4 потока)\n", f.result, now() - t0); // 196418
+    FJ_Destroy(&pool);
+
+    // Тест 2: Сортировка 20 млн чисел, 1 поток против всех ядер
+    long n = 20000000;
+    int* src = malloc(sizeof(int) * n);
+    int* a = malloc(sizeof(int) * n);
+    srand(1);
+    for (long i = 0; i < n; i++) src[i] = rand();
+    printf("\nТест 2: сортировка %ld чисел (ядер: %ld)\n", n, cpus);
+    int counts[] = {1, cpus > 1 ? (int)cpus : 4};
+    for (int k = 0; k < 2; k++) {
+        memcpy(a, src, sizeof(int) * n);
+        FJ_Create(&pool, counts[k]);
+        Range r = {a, n};
+        t0 = now();
+        FJ_Run(&pool, psort, &r);
+        double t = now() - t0;
+        FJ_Destroy(&pool);
+        bool sorted = true;
+        for (long i = 1; i < n; i++) sorted &= a[i - 1] <= a[i];
+        printf("потоков %2d: %.3f с, отсортировано? %s\n", counts[k], t,
+               sorted ? "Да" : "Нет");
+    }
+
+    // Тест 3: Fork вне пула - выполняется сразу
+    Fib g = {20, 0};
+    fib(&g);
+    printf("\nТест 3: fib(20) без пула = %ld\n", g.result); // 6765
+
+    free(src);
+    free(a);
+    return 0;
+}
+*/
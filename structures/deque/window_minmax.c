@@ -0,0 +1,394 @@
+// Минимум и максимум в скользящем окне (монотонный дек)
+// Потоковый оператор: отсчёты поступают по одному или пачками, после
+// каждого известны min и max последних w отсчётов (или последних
+// span единиц времени) - за амортизированное O(1) на отсчёт
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ============================================================
+   ШПАРГАЛКА: Окно min/max (WindowMinMax)
+   ============================================================
+   typedef struct {
+       WindowEntry* items;  // кольцевой буфер пар (значение, ключ)
+       size_t mask;         // вместимость - 1 (вместимость - 2^k)
+       size_t head;         // индекс левого элемента
+       size_t size;         // размер дека
+   } WindowDeque;           // дек на кольцевом буфере, операции как
+                            // в deque_dyn.c: PushRight, PopLeft, PopRight
+   typedef struct {
+       WindowKind kind;     // окно в отсчётах или во времени
+       long long span;      // w отсчётов или длительность окна
+       long long count;     // сколько отсчётов принято
+       long long last;      // ключ последнего отсчёта
+       WindowDeque min;     // значения возрастают слева направо
+       WindowDeque max;     // значения убывают слева направо
+   } WindowMinMax;
+   ФУНКЦИИ:
+   bool WM_CreateCount(WindowMinMax* w, long long size)   N → Window
+   bool WM_CreateTime(WindowMinMax* w, long long span)    N → Window
+   void WM_Destroy(WindowMinMax* w)                       Window → ∅
+   bool WM_Empty(WindowMinMax* w)                         Window → boolean
+   bool WM_Push(WindowMinMax* w, double v)                окно в отсчётах
+   bool WM_PushAt(WindowMinMax* w, long long t, double v) окно во времени
+   size_t WM_PushBatch(WindowMinMax* w, const double* v, size_t n,
+                       double* outMin, double* outMax)
+   size_t WM_PushBatchAt(WindowMinMax* w, const long long* t,
+                         const double* v, size_t n,
+                         double* outMin, double* outMax)
+   void WM_Advance(WindowMinMax* w, long long now)        сдвинуть окно
+   double WM_Min(WindowMinMax* w)                         Window → double
+   double WM_Max(WindowMinMax* w)                         Window → double
+   ============================================================
+
+   ИДЕЯ (для максимума, минимум - симметрично):
+     Дек хранит только тех, кто ещё может стать максимумом окна:
+     значения строго убывают слева направо
+
+       новый отсчёт x:  пока справа значение ≤ x - PopRight
+                        (они старше x и не больше - до конца жизни
+                        в окне их перекрывает x), затем PushRight(x)
+       сдвиг окна:      пока слева ключ вышел из окна - PopLeft
+       максимум:        левый элемент дека
+
+     Пример, окно 3:  поток 5 3 4 1 2
+       5 → [5]        max 5
+       3 → [5 3]      max 5
+       4 → [5 4]      max 5    (3 вытеснен четвёркой)
+       1 → [4 1]      max 4    (5 вышел из окна)
+       2 → [4 2]      max 4    (1 вытеснен двойкой)
+
+   - Каждый отсчёт один раз входит в дек и не больше одного раза
+     выходит: O(1) амортизированно, независимо от ширины окна
+   - Ключ отсчёта - его номер (окно в отсчётах: последние size штук)
+     или время (окно во времени: ключи из (t - span, t])
+   - Окно в отсчётах: в деке не больше size элементов - буфер
+     выделяется один раз. Во времени - растёт вдвое по необходимости;
+     не хватило памяти - отсчёт не принят (Push - false, пачка -
+     сколько принято), окно остаётся прежним
+   - Время не должно убывать; NaN в значениях не допускается
+*/
+
+// Начальная вместимость дека для окна во времени
+#define WINDOW_MIN_CAPACITY 64
+
+typedef enum {
+    WINDOW_COUNT,   // последние span отсчётов
+    WINDOW_TIME     // отсчёты с временем из (last - span, last]
+} WindowKind;
+
+typedef struct {
+    double value;
+    long long key;   // номер отсчёта или время
+} WindowEntry;
+
+typedef struct {
+    WindowEntry* items;
+    size_t mask;
+    size_t head;
+    size_t size;
+} WindowDeque;
+
+typedef struct {
+    WindowKind kind;
+    long long span;
+    long long count;
+    long long last;
+    WindowDeque min;
+    WindowDeque max;
+} WindowMinMax;
+
+// ============ ДЕК НА КОЛЬЦЕВОМ БУФЕРЕ ============
+
+static bool WD_Create(WindowDeque* d, size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    d->items = malloc(sizeof(WindowEntry) * cap);
+    d->mask = cap - 1;
+    d->head = 0;
+    d->size = 0;
+    return d->items != NULL;
+}
+
+// Буфер вдвое больше, элементы - с начала
+static bool WD_Grow(WindowDeque* d) {
+    size_t cap = (d->mask + 1) * 2;
+    WindowEntry* items = malloc(sizeof(WindowEntry) * cap);
+    if (!items) return false;
+    for (size_t i = 0; i < d->size; i++) {
+        items[i] = d->items[(d->head + i) & d->mask];
+    }
+    free(d->items);
+    d->items = items;
+    d->mask = cap - 1;
+    d->head = 0;
+    return true;
+}
+
+static WindowEntry* WD_Left(WindowDeque* d) {
+    return &d->items[d->head];
+}
+
+static WindowEntry* WD_Right(WindowDeque* d) {
+    return &d->items[(d->head + d->size - 1) & d->mask];
+}
+
+static bool WD_PushRight(WindowDeque* d, double value, long long key) {
+    if (d->size > d->mask && !WD_Grow(d)) {
+        return false;
+    }
+    WindowEntry* e = &d->items[(d->head + d->size) & d->mask];
+    e->value = value;
+    e->key = key;
+    d->size++;
+    return true;
+}
+
+// Место ещё под один элемент (рост не меняет содержимое дека)
+static bool WD_Reserve(WindowDeque* d) {
+    return d->size <= d->mask || WD_Grow(d);
+}
+
+static void WD_PopLeft(WindowDeque* d) {
+    d->head = (d->head + 1) & d->mask;
+    d->size--;
+}
+
+static void WD_PopRight(WindowDeque* d) {
+    d->size--;
+}
+
+// ============ ОКНО ============
+
+static bool WM_Create(WindowMinMax* w, WindowKind kind, long long span, size_t capacity) {
+    w->kind = kind;
+    w->span = (span > 0) ? span : 1;
+    w->count = 0;
+    w->last = 0;
+    // Неудачное создание оставляет оба указателя NULL - WM_Destroy безопасен
+    w->min.items = w->max.items = NULL;
+    if (!WD_Create(&w->min, capacity)) return false;
+    if (!WD_Create(&w->max, capacity)) {
+        free(w->min.items);
+        w->min.items = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Окно из последних size отсчётов
+bool WM_CreateCount(WindowMinMax* w, long long size) {
+    // +1: новый отсчёт добавляется раньше, чем выходит старый
+    return WM_Create(w, WINDOW_COUNT, size, (size_t)(size > 0 ? size : 1) + 1);
+}
+
+// Окно из отсчётов за последние span единиц времени
+bool WM_CreateTime(WindowMinMax* w, long long span) {
+    return WM_Create(w, WINDOW_TIME, span, WINDOW_MIN_CAPACITY);
+}
+
+void WM_Destroy(WindowMinMax* w) {
+    free(w->min.items);
+    free(w->max.items);
+    w->min.items = w->max.items = NULL;
+    w->min.size = w->max.size = 0;
+}
+
+// Пусто ли окно (ещё не было отсчётов или все устарели)
+bool WM_Empty(WindowMinMax* w) {
+    return w->max.size == 0;
+}
+
+// Убрать слева всё с ключом ≤ edge
+static void WM_Expire(WindowMinMax* w, long long edge) {
+    while (w->min.size && WD_Left(&w->min)->key <= edge) WD_PopLeft(&w->min);
+    while (w->max.size && WD_Left(&w->max)->key <= edge) WD_PopLeft(&w->max);
+}
+
+// Добавить отсчёт с ключом key и сдвинуть окно
+// false - не хватило памяти, окно не изменилось
+static bool WM_Add(WindowMinMax* w, long long key, double v) {
+    // Место - заранее в обоих деках: иначе отсчёт мог бы попасть
+    // только в один из них, и min и max разошлись бы
+    if (!WD_Reserve(&w->min) || !WD_Reserve(&w->max)) {
+        return false;
+    }
+    // Вытесняем тех, кто уже никогда не станет минимумом/максимумом
+    while (w->min.size && WD_Right(&w->min)->value >= v) WD_PopRight(&w->min);
+    while (w->max.size && WD_Right(&w->max)->value <= v) WD_PopRight(&w->max);
+    WD_PushRight(&w->min, v, key);
+    WD_PushRight(&w->max, v, key);
+    w->count++;
+    w->last = key;
+    WM_Expire(w, key - w->span);
+    return true;
+}
+
+// Следующий отсчёт окна в отсчётах; false - не хватило памяти
+bool WM_Push(WindowMinMax* w, double v) {
+    return WM_Add(w, w->count, v);
+}
+
+// Отсчёт со временем t (не меньше предыдущего) для окна во времени
+// false - не хватило памяти
+bool WM_PushAt(WindowMinMax* w, long long t, double v) {
+    return WM_Add(w, t, v);
+}
+
+// Пачка отсчётов; outMin[i] / outMax[i] - min/max окна после v[i]
+// (outMin / outMax могут быть NULL, если нужен только итог)
+// Возвращает, сколько отсчётов принято (меньше n - не хватило памяти)
+size_t WM_PushBatch(WindowMinMax* w, const double* v, size_t n,
+                    double* outMin, double* outMax) {
+    for (size_t i = 0; i < n; i++) {
+        if (!WM_Add(w, w->count, v[i])) return i;
+        if (outMin) outMin[i] = WD_Left(&w->min)->value;
+        if (outMax) outMax[i] = WD_Left(&w->max)->value;
+    }
+    return n;
+}
+
+// То же для окна во времени: t[i] - время отсчёта v[i]
+size_t WM_PushBatchAt(WindowMinMax* w, const long long* t, const double* v, size_t n,
+                      double* outMin, double* outMax) {
+    for (size_t i = 0; i < n; i++) {
+        if (!WM_Add(w, t[i], v[i])) return i;
+        if (outMin) outMin[i] = WD_Left(&w->min)->value;
+        if (outMax) outMax[i] = WD_Left(&w->max)->value;
+    }
+    return n;
+}
+
+// Окно во времени: сдвинуть конец окна к now без нового отсчёта
+// (метрика замолчала - старые значения должны устаревать)
+void WM_Advance(WindowMinMax* w, long long now) {
+    if (w->kind == WINDOW_TIME && now > w->last) {
+        w->last = now;
+        WM_Expire(w, now - w->span);
+    }
+}
+
+// Минимум окна (0, если окно пусто)
+double WM_Min(WindowMinMax* w) {
+    return w->min.size ? WD_Left(&w->min)->value : 0;
+}
+
+// Максимум окна (0, если окно пусто)
+double WM_Max(WindowMinMax* w) {
+    return w->max.size ? WD_Left(&w->max)->value : 0;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// WM_Push / WM_PushAt: O(1) амортизированное - каждый отсчёт входит
+//                      в каждый дек один раз и выходит не больше раза
+//                      (отдельный вызов - до O(w), если вытесняет многих)
+// WM_PushBatch: O(n) на пачку из n отсчётов
+// WM_Min / WM_Max: O(1) - левый элемент дека
+// WM_Advance: O(устаревших)
+// Память: O(w) - в худшем случае (монотонный поток) дек хранит всё окно;
+//         на случайных данных - O(log w) элементов в среднем
+//
+// Сравнение с пересчётом окна на каждом отсчёте: O(w) → O(1);
+// при w = 10 000 - в сотни раз быстрее
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <time.h>
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Пересчёт окна целиком - для сравнения
+static void naive(const double* v, long long i, long long w, double* mn, double* mx) {
+    long long from = (i - w + 1 > 0) ? i - w + 1 : 0;
+    *mn = *mx = v[from];
+    for (long long j = from + 1; j <= i; j++) {
+        if (v[j] < *mn) *mn = v[j];
+        if (v[j] > *mx) *mx = v[j];
+    }
+}
+
+int main() {
+    printf("=== Min/max в скользящем окне ===\n\n");
+
+    // Тест 1: Окно из 3 отсчётов
+    WindowMinMax w;
+    WM_CreateCount(&w, 3);
+    double s[] = {5, 3, 4, 1, 2, 6};
+    printf("Тест 1: окно 3\n");
+    for (int i = 0; i < 6; i++) {
+        WM_Push(&w, s[i]);
+        printf("  +%.0f → min %.0f, max %.0f\n", s[i], WM_Min(&w), WM_Max(&w));
+    } // max: 5 5 5 4 4 6, min: 5 3 3 1 1 1
+    WM_Destroy(&w);
+
+    // Тест 2: Окно во времени - 10 секунд, отсчёты нерегулярные
+    WM_CreateTime(&w, 10);
+    long long ts[] = {0, 2, 3, 11, 12, 25};
+    double vs[] = {7, 9, 1, 4, 3, 8};
+    double mn[6], mx[6];
+    WM_PushBatchAt(&w, ts, vs, 6, mn, mx);
+    printf("\nТест 2: окно 10 с, пачкой\n");
+    for (int i = 0; i < 6; i++)
+        printf("  t=%2lld %.0f → min %.0f, max %.0f\n", ts[i], vs[i], mn[i], mx[i]);
+    // t=11: окно (1, 11] - без отсчёта t=0 → min 1, max 9
+    // t=25: окно (15, 25] - только 8
+    WM_Advance(&w, 40);
+    printf("  тишина до t=40: окно пусто? %s\n", WM_Empty(&w) ? "Да" : "Нет"); // Да
+    WM_Destroy(&w);
+
+    // Тест 3: Сверка с пересчётом на случайном потоке
+    long long n = 200000;
+    double* v = malloc(sizeof(double) * n);
+    double* bmn = malloc(sizeof(double) * n);
+    double* bmx = malloc(sizeof(double) * n);
+    srand(7);
+    for (long long i = 0; i < n; i++) v[i] = rand() % 1000;
+    bool ok = true;
+    long long sizes[] = {1, 2, 17, 1000};
+    for (int k = 0; k < 4; k++) {
+        WM_CreateCount(&w, sizes[k]);
+        WM_PushBatch(&w, v, 50000, bmn, bmx);
+        for (long long i = 0; i < 50000; i++) {
+            double a, b;
+            naive(v, i, sizes[k], &a, &b);
+            ok &= (a == bmn[i] && b == bmx[i]);
+        }
+        WM_Destroy(&w);
+    }
+    printf("\nТест 3: совпадает с пересчётом окна? %s\n", ok ? "Да" : "Нет"); // Да
+
+    // Тест 4: w = 10 000 - дек против пересчёта
+    long long win = 10000;
+    double t0 = now();
+    volatile double chk = 0;  // чтобы компилятор не выбросил цикл
+    for (long long i = 0; i < 20000; i++) {
+        double a, b;
+        naive(v, i, win, &a, &b);
+        chk += b - a;
+    }
+    double tNaive = (now() - t0) / 20000;
+
+    WM_CreateCount(&w, win);
+    t0 = now();
+    for (int r = 0; r < 50; r++) WM_PushBatch(&w, v, n, bmn, bmx);
+    double tDeque = (now() - t0) / (50.0 * n);
+    WM_Destroy(&w);
+    printf("\nТест 4: окно %lld\n", win);
+    printf("пересчёт окна:  %8.1f нс на отсчёт\n", tNaive * 1e9);
+    printf("монотонный дек: %8.1f нс на отсчёт (в %.0f раз быстрее)\n",
+           tDeque * 1e9, tNaive / tDeque);
+
+    free(v);
+    free(bmn);
+    free(bmx);
+    return 0;
+}
+*/
@@ -4,17 +4,21 @@
 typedef void* T;
 
 /* ============================================================
-   ШПАРГАЛКА: Очередь на динамическом списке (Queue)
+   ШПАРГАЛКА: Очередь на списке блоков (Queue)
    ============================================================
    typedef struct {
-       QNode* head;  // голова
-       QNode* tail;  // терминатор(хвост)
-       int size;     // размер очереди
+       QChunk* head;    // блок с первым элементом
+       int headPos;     // индекс первого элемента в head
+       QChunk* tail;    // блок для записи
+       int tailPos;     // индекс первой свободной ячейки в tail
+       QChunk* spare;   // запасные блоки для повторного использования
+       int spareCount;  // их количество
+       int size;        // размер очереди
    } QueueDynamic;
-   typedef struct QNode {
-       T data;              // данные элемента
-       struct QNode* next;  // следующий элемент
-   } QNode;
+   typedef struct QChunk {
+       T data[QD_CHUNK];     // QD_CHUNK элементов подряд
+       struct QChunk* next;  // следующий блок
+   } QChunk;
    ФУНКЦИИ:
    void QD_Create(QueueDynamic* q)      ∅ → Queue
    bool QD_Empty(const QueueDynamic* q) Queue → boolean
@@ -23,78 +27,158 @@ typedef void* T;
    T QD_Top(const QueueDynamic* q)      Queue → T
    bool QD_Pop(QueueDynamic* q)         Queue → Queue
    void QD_Destroy(QueueDynamic* q)     Queue → ∅
-   ============================================================ */
+   ============================================================
+
+   Список не из отдельных узлов, а из блоков по QD_CHUNK элементов
+   (развёрнутый список, unrolled list):
+
+     head                                tail
+      ↓                                   ↓
+     [ . . . x x x x ] → [ x x x x x x x ] → [ x x x . . . . ]
+             ↑headPos                                ↑tailPos
+
+   - Push пишет в tail->data[tailPos]; новый блок - только когда tail полон
+   - Pop сдвигает headPos; опустевший блок уходит в запас (spare)
+     и переиспользуется следующим Push - при равномерном потоке
+     malloc/free не вызываются совсем
+   - Элементы блока лежат подряд: один промах кэша на QD_CHUNK операций,
+     а не на каждую
+*/
+
+// Элементов в блоке
+#define QD_CHUNK 128
+
+// Сколько опустевших блоков держать про запас (остальные освобождаются)
+#define QD_SPARE_MAX 4
 
-typedef struct QNode {
-    T               data;
-    struct QNode*   next;
-} QNode;
+typedef struct QChunk {
+    T               data[QD_CHUNK];
+    struct QChunk*  next;
+} QChunk;
 
 typedef struct {
-    QNode* head;  // первый элемент
-    QNode* tail;  // терминатор
-    int    size;
+    QChunk* head;       // блок с первым элементом
+    int     headPos;
+    QChunk* tail;       // блок для записи
+    int     tailPos;
+    QChunk* spare;      // стек запасных блоков
+    int     spareCount;
+    int     size;
 } QueueDynamic;
 
+// Взять блок из запаса или выделить новый
+static QChunk* QD_TakeChunk(QueueDynamic* q) {
+    QChunk* c = q->spare;
+    if (c) {
+        q->spare = c->next;
+        q->spareCount--;
+    } else {
+        c = malloc(sizeof(QChunk));
+        if (!c) return NULL;
+    }
+    c->next = NULL;
+    return c;
+}
+
+// Вернуть блок в запас (или освободить, если запас полон)
+static void QD_ReleaseChunk(QueueDynamic* q, QChunk* c) {
+    if (q->spareCount < QD_SPARE_MAX) {
+        c->next = q->spare;
+        q->spare = c;
+        q->spareCount++;
+    } else {
+        free(c);
+    }
+}
+
 void QD_Create(QueueDynamic* q) {
-    q->head = q->tail = malloc(sizeof(QNode));
+    q->spare = NULL;
+    q->spareCount = 0;
+    q->head = q->tail = QD_TakeChunk(q);
+    q->headPos = q->tailPos = 0;
     q->size = 0;
 }
 
-bool QD_Empty(const QueueDynamic* q) { return q->size == 0;  } // или return q->head == q->tail
+bool QD_Empty(const QueueDynamic* q) { return q->size == 0; }
 int  QD_Size (const QueueDynamic* q) { return q->size; }
 
 bool QD_Push(QueueDynamic* q, T t) {
-    QNode* n = malloc(sizeof(QNode));
-    if (!n) return false;
-    q->tail->next = n;
-    q->tail->data = t; // в последний узел записываем данные, а созданный становится терминатором
-    q->tail = q->tail->next;
+    if (q->tailPos == QD_CHUNK) {  // блок заполнен - подцепляем следующий
+        QChunk* c = QD_TakeChunk(q);
+        if (!c) return false;
+        q->tail->next = c;
+        q->tail = c;
+        q->tailPos = 0;
+    }
+    q->tail->data[q->tailPos++] = t;
     q->size++;
     return true;
 }
 
 T QD_Top(const QueueDynamic* q) {
     if (q->size != 0) {
-        return q->head->data;
+        return q->head->data[q->headPos];
     }
     return 0;
 }
 
 bool QD_Pop(QueueDynamic* q) {
     if (q->size == 0) return false;
-    QNode* first = q->head;
-    q->head = q->head->next;
-    free(first);
     q->size--;
+    if (q->size == 0) {  // очередь пуста: head == tail, пишем блок с начала
+        q->headPos = q->tailPos = 0;
+        return true;
+    }
+    if (++q->headPos == QD_CHUNK) {  // блок прочитан целиком
+        QChunk* first = q->head;
+        q->head = first->next;
+        q->headPos = 0;
+        QD_ReleaseChunk(q, first);
+    }
     return true;
 }
 
 void QD_Destroy(QueueDynamic* q) {
-    while (!QD_Empty(q)) {
-        QNode* pi = q->head;
-        q->head = q->head->next;
-        free(pi);
+    while (q->head) {
+        QChunk* c = q->head;
+        q->head = c->next;
+        free(c);
+    }
+    while (q->spare) {
+        QChunk* c = q->spare;
+        q->spare = c->next;
+        free(c);
     }
-    free(q->head);
     q->head = q->tail = 0;
+    q->spareCount = 0;
+    q->headPos = q->tailPos = 0;
     q->size = 0;
 }
 
 // ============ СЛОЖНОСТЬ ============
-// QD_Create: O(1) - инициализация
-// QD_Push: O(1) - добавление в конец
-// QD_Pop: O(1) - удаление из начала
+// QD_Create: O(1) - один блок
+// QD_Push: O(1) - malloc не чаще раза на QD_CHUNK добавлений
+//          (и вовсе нет, пока хватает запасных блоков)
+// QD_Pop: O(1) - блок возвращается в запас раз на QD_CHUNK удалений
 // QD_Top: O(1) - просмотр первого элемента
 // QD_Empty: O(1) - проверка пустоты
 // QD_Size: O(1) - получение размера
-// QD_Destroy: O(n) - удаление всех элементов
-// Память: O(n) - односвязный список с терминатором
+// QD_Destroy: O(n / QD_CHUNK) - освобождение блоков
+// Память: ≈ 8 байт на элемент + 8 / QD_CHUNK на указатель next
+//         (узел на элемент: 16 байт + ~16 байт заголовка malloc)
+//         + не больше (QD_SPARE_MAX + 1) блоков неиспользуемого места
 
 // ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
 
 /*
 #include <stdio.h>
+#include <time.h>
+
+// Узел прежней реализации - для сравнения в тесте 5
+typedef struct QNodeOld {
+    T data;
+    struct QNodeOld* next;
+} QNodeOld;
 
 int main() {
     printf("=== Очередь (Queue) на динамических структурах ===\n\n");
@@ -134,8 +218,53 @@ int main() {
         QD_Pop(&q2);
     }
     
+    // Тест 4: Много элементов - переход через границы блоков
+    printf("\nТест 4: %d элементов через границы блоков\n", QD_CHUNK * 5 + 7);
+    QueueDynamic q3;
+    QD_Create(&q3);
+    bool fifo = true;
+    long next = 0;
+    for (long i = 0; i < QD_CHUNK * 5 + 7; i++) {
+        QD_Push(&q3, (void*)i);
+        if (i % 3 == 0) {  // удаляем медленнее, чем добавляем
+            fifo &= (long)QD_Top(&q3) == next++;
+            QD_Pop(&q3);
+        }
+    }
+    while (!QD_Empty(&q3)) {
+        fifo &= (long)QD_Top(&q3) == next++;
+        QD_Pop(&q3);
+    }
+    printf("Порядок FIFO сохранён? %s, запасных блоков: %d\n",
+           fifo ? "Да" : "Нет", q3.spareCount); // Да, 4
+
+    // Тест 5: Равномерный поток push/pop - блоки против узла на элемент
+    int ops = 20000000, backlog = 1000;
+    clock_t t0 = clock();
+    QNodeOld* h = malloc(sizeof(QNodeOld));  // старый вариант: malloc на узел
+    QNodeOld* tl = h;
+    for (int i = 0; i < ops; i++) {
+        QNodeOld* n = malloc(sizeof(QNodeOld));
+        tl->data = (void*)(long)i; tl->next = n; tl = n;
+        if (i >= backlog) { QNodeOld* f = h; h = h->next; free(f); }
+    }
+    while (h != tl) { QNodeOld* f = h; h = h->next; free(f); }
+    free(h);
+    double tNodes = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    for (int i = 0; i < ops; i++) {
+        QD_Push(&q3, (void*)(long)i);
+        if (i >= backlog) QD_Pop(&q3);
+    }
+    double tChunks = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    printf("\nТест 5: %d операций, в очереди ~%d элементов\n", ops, backlog);
+    printf("узел на элемент: %.3f с\n", tNodes);
+    printf("блоки по %d:     %.3f с\n", QD_CHUNK, tChunks);
+
     QD_Destroy(&q1);
     QD_Destroy(&q2);
+    QD_Destroy(&q3);
     
     return 0;
 }
@@ -0,0 +1,389 @@
+// Очередь в отображённом файле (Memory-mapped Queue)
+// Кольцевой буфер прямо в файле: переживает перезапуск и падение процесса
+// Альтернатива queue_file.c с тем же набором функций
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define QUEUE_EMPTY -1
+
+// Вместимость по умолчанию (байт данных)
+#define QUEUE_MMAP_CAPACITY (64L * 1024 * 1024)
+
+#define QUEUE_MMAP_MAGIC 0x51554555454d4d41ull  // "AMMEUEUQ"
+#define QUEUE_MMAP_VERSION 1
+
+/* ============================================================
+   ШПАРГАЛКА: Очередь в отображённом файле (Mmap Queue)
+   ============================================================
+
+   СТРУКТУРА:
+   typedef struct {            // первая страница файла
+       uint64_t magic;         // признак файла очереди
+       uint32_t version;
+       uint64_t capacity;      // размер области данных (кратен странице)
+       uint64_t head;          // байт прочитано за всё время
+       uint64_t tail;          // байт записано за всё время
+   } QueueHeader;
+   typedef struct {
+       int fd;                 // файл (заблокирован flock)
+       QueueHeader* hdr;       // заголовок в памяти = в файле
+       char* data;             // область данных, отображённая ДВАЖДЫ
+       uint64_t capacity;
+       size_t mapLen;
+   } Queue;
+
+   ФУНКЦИИ:
+   bool init(Queue* q, const char* path)              ∅ → Queue
+   bool initWith(Queue* q, const char* path, long capacity)
+   bool isEmpty(Queue* q)                             Queue → boolean
+   long long size(Queue* q)                           Queue → N
+   bool push(Queue* q, int val)                       Queue × int → Queue
+   size_t pushBatch(Queue* q, const int* vals, size_t n)
+   int top(Queue* q)                                  Queue → int
+   bool pop(Queue* q, int* out)                       Queue × int* → Queue
+   size_t popBatch(Queue* q, int* out, size_t n)
+   bool flush(Queue* q)                               сбросить на диск (msync)
+   void destroy(Queue* q)                             Queue → ∅ (файл остаётся)
+   ============================================================
+
+   ФАЙЛ:
+     [ заголовок: 1 страница ][ данные: capacity байт ]
+
+   ПАМЯТЬ (данные отображены два раза подряд):
+     [ заголовок ][ данные ][ данные ещё раз ]
+                   ↑ data    ↑ data + capacity - те же страницы файла
+
+   - Позиция элемента: data + (offset % capacity). Пачка, которая
+     перешла через конец буфера, продолжается во "второй копии" -
+     memcpy одним куском, без разбора случаев
+   - head и tail - счётчики в заголовке (только растут):
+     размер = tail - head, полна ⟺ tail - head == capacity
+   - push: записать данные, затем tail. Обычные записи в память -
+     ни одного системного вызова
+   - Память MAP_SHARED - это страничный кэш файла. Если процесс упал,
+     всё, что он успел записать, уже "в файле": при следующем init
+     очередь открывается с теми же head и tail
+   - Падение посреди создания файла (размер задан, magic ещё не записан):
+     заголовок нулевой - следующий init просто создаёт очередь заново
+   - Между вызовами flush() защищено только падение ПРОЦЕССА. Ядро
+     пишет изменённые страницы на диск в любом порядке: после сбоя ОС /
+     питания заголовок может оказаться новее данных (tail указывает
+     на мусор) или старее
+   - flush() (msync: сначала данные, потом заголовок) оставляет на диске
+     согласованную очередь. Сбой ОС её не портит, только если после
+     последнего flush() в очередь не писали
+*/
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t capacity;
+    uint64_t head;
+    uint64_t tail;
+} QueueHeader;
+
+typedef struct Queue {
+    int fd;
+    QueueHeader* hdr;
+    char* data;
+    uint64_t capacity;
+    size_t mapLen;
+} Queue;
+
+// Отобразить заголовок и дважды область данных (capacity кратна странице)
+static bool mapRing(Queue* q, size_t page) {
+    q->mapLen = page + 2 * q->capacity;
+
+    // Резервируем непрерывный кусок адресов, затем накрываем его файлом
+    char* base = mmap(NULL, q->mapLen, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return false;
+
+    // [заголовок][данные] - файл с начала
+    void* first = mmap(base, page + q->capacity, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_FIXED, q->fd, 0);
+    // [данные ещё раз] - та же область файла сразу за первой копией
+    void* second = mmap(base + page + q->capacity, q->capacity,
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                        q->fd, (off_t)page);
+    if (first == MAP_FAILED || second == MAP_FAILED) {
+        munmap(base, q->mapLen);
+        return false;
+    }
+
+    q->hdr = (QueueHeader*)base;
+    q->data = base + page;
+    return true;
+}
+
+// Закрыть файл при неудачном открытии: destroy не должен закрыть
+// этот номер дескриптора ещё раз (его может получить другой файл)
+static bool initFail(Queue* q) {
+    close(q->fd);
+    q->fd = -1;
+    return false;
+}
+
+// Заголовок из одних нулей: процесс упал между ftruncate и записью magic
+static bool headerZero(const QueueHeader* h) {
+    static const QueueHeader zero;
+    return memcmp(h, &zero, sizeof(zero)) == 0;
+}
+
+// Открыть очередь из файла path или создать новую на capacity байт
+// Существующий файл открывается с его head/tail (capacity берётся из файла)
+// false - файл занят другим процессом, повреждён или нет памяти/места
+bool initWith(Queue* q, const char* path, long capacity) {
+    memset(q, 0, sizeof(*q));
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    q->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (q->fd < 0) return false;
+
+    // Один владелец: второй процесс испортил бы head/tail
+    if (flock(q->fd, LOCK_EX | LOCK_NB) < 0) {
+        return initFail(q);
+    }
+
+    struct stat st;
+    if (fstat(q->fd, &st) < 0) {
+        return initFail(q);
+    }
+
+    // Новый файл: пустой или недосозданный - размер уже задан, а заголовок
+    // ещё нулевой (magic пишется последним). Данных в нём нет - создаём заново
+    QueueHeader h;
+    bool fresh = (st.st_size == 0) ||
+                 ((uint64_t)st.st_size > page &&
+                  pread(q->fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h) &&
+                  headerZero(&h));
+
+    if (fresh) {
+        if (capacity < (long)page) capacity = (long)page;
+        q->capacity = ((uint64_t)capacity + page - 1) / page * page;
+        if (ftruncate(q->fd, (off_t)(page + q->capacity)) < 0) {
+            return initFail(q);
+        }
+        // ftruncate даёт разреженный файл: блоки выделялись бы при первой
+        // записи в страницу, и на полном диске push получил бы SIGBUS.
+        // Выделяем их сразу - нет места → ошибка здесь, а не в push
+        if (posix_fallocate(q->fd, 0, (off_t)(page + q->capacity)) != 0) {
+            return initFail(q);
+        }
+    } else {
+        // Проверяем заголовок до отображения всего файла
+        if (pread(q->fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h) ||
+            h.magic != QUEUE_MMAP_MAGIC || h.version != QUEUE_MMAP_VERSION ||
+            h.capacity == 0 || h.capacity % page != 0 ||
+            (uint64_t)st.st_size != page + h.capacity ||
+            h.tail < h.head || h.tail - h.head > h.capacity ||
+            (h.tail - h.head) % sizeof(int) != 0) {
+            return initFail(q);
+        }
+        q->capacity = h.capacity;
+    }
+
+    if (!mapRing(q, page)) {
+        return initFail(q);
+    }
+
+    if (fresh) {
+        q->hdr->capacity = q->capacity;
+        q->hdr->head = 0;
+        q->hdr->tail = 0;
+        q->hdr->version = QUEUE_MMAP_VERSION;
+        q->hdr->magic = QUEUE_MMAP_MAGIC;  // последним: файл готов
+    }
+    return true;
+}
+
+// Открыть или создать очередь с вместимостью по умолчанию
+bool init(Queue* queue, const char* filename) {
+    return initWith(queue, filename, QUEUE_MMAP_CAPACITY);
+}
+
+// Проверка, пуста ли очередь
+bool isEmpty(Queue* queue) {
+    return queue->hdr->tail == queue->hdr->head;
+}
+
+// Получение текущего размера очереди
+long long size(Queue* queue) {
+    return (long long)((queue->hdr->tail - queue->hdr->head) / sizeof(int));
+}
+
+// Добавление n элементов; возвращает, сколько поместилось
+size_t pushBatch(Queue* queue, const int* vals, size_t n) {
+    QueueHeader* h = queue->hdr;
+    size_t room = (size_t)(queue->capacity - (h->tail - h->head)) / sizeof(int);
+    if (n > room) n = room;
+    if (n == 0) return 0;
+    // Переход через конец буфера попадает во вторую копию
+    memcpy(queue->data + h->tail % queue->capacity, vals, n * sizeof(int));
+    // Данные - до tail: после падения tail не укажет на мусор
+    __atomic_store_n(&h->tail, h->tail + n * sizeof(int), __ATOMIC_RELEASE);
+    return n;
+}
+
+// Добавление элемента в конец очереди; false - очередь полна
+bool push(Queue* queue, int val) {
+    return pushBatch(queue, &val, 1) == 1;
+}
+
+// Извлечение до n элементов; возвращает, сколько извлечено
+size_t popBatch(Queue* queue, int* out, size_t n) {
+    QueueHeader* h = queue->hdr;
+    size_t avail = (size_t)(h->tail - h->head) / sizeof(int);
+    if (n > avail) n = avail;
+    if (n == 0) return 0;
+    memcpy(out, queue->data + h->head % queue->capacity, n * sizeof(int));
+    __atomic_store_n(&h->head, h->head + n * sizeof(int), __ATOMIC_RELEASE);
+    return n;
+}
+
+// Извлечение элемента из начала очереди (с удалением)
+bool pop(Queue* queue, int* out) {
+    return popBatch(queue, out, 1) == 1;
+}
+
+// Просмотр первого элемента без удаления
+// Возвращает QUEUE_EMPTY (-1) если очередь пуста
+int top(Queue* queue) {
+    if (isEmpty(queue)) return QUEUE_EMPTY;
+    int val;
+    memcpy(&val, queue->data + queue->hdr->head % queue->capacity, sizeof(int));
+    return val;
+}
+
+// Сбросить изменения на диск: сначала данные, потом заголовок
+bool flush(Queue* queue) {
+    bool ok = msync(queue->data, queue->capacity, MS_SYNC) == 0;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return msync(queue->hdr, page, MS_SYNC) == 0 && ok;
+}
+
+// Закрыть очередь. Файл и его содержимое остаются - следующий init
+// продолжит с того же места. Удалить очередь совсем: remove(path)
+void destroy(Queue* queue) {
+    if (queue->hdr) munmap(queue->hdr, queue->mapLen);
+    if (queue->fd >= 0) close(queue->fd);  // снимает и flock
+    memset(queue, 0, sizeof(*queue));
+    queue->fd = -1;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// init: O(1) - отображение файла (страницы подгружаются по мере обращения)
+// push / pop / top: O(1) - запись/чтение памяти, без системных вызовов
+// pushBatch / popBatch: O(n) - один memcpy даже через конец буфера
+// flush: O(изменённых страниц) - запись на диск
+// Память: capacity байт адресного пространства ×2 (физически - один раз,
+//         в страничном кэше)
+//
+// Сравнение с queue_file.c:
+// - queue_file: неограниченный размер, write/pread раз на 256 КБ;
+//   данные в буфере при падении процесса теряются
+// - queue_mmap: размер ограничен capacity; ни одного системного вызова
+//   на горячем пути; падение процесса ничего не теряет
+//
+// Ограничения:
+// - Открыть очередь может только один процесс (flock)
+// - Сбой ОС / питания после изменений без flush: на диске может быть
+//   tail новее данных - очередь вернёт мусор. Для такой надёжности
+//   flush() после каждой пачки или queue_file.c (CRC каждой записи)
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <time.h>
+#include <sys/wait.h>
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main() {
+    printf("=== Очередь в отображённом файле ===\n\n");
+    const char* path = "/tmp/queue_mmap_test.dat";
+    remove(path);
+
+    // Тест 1: FIFO и сохранение между запусками
+    Queue q;
+    init(&q, path);
+    push(&q, 10);
+    push(&q, 20);
+    push(&q, 30);
+    destroy(&q);  // "перезапуск"
+
+    init(&q, path);
+    printf("Тест 1: после переоткрытия размер %lld, первый %d\n",
+           size(&q), top(&q)); // 3, 10
+    int val;
+    while (pop(&q, &val)) printf("Извлечен: %d\n", val);
+    destroy(&q);
+
+    // Тест 2: Падение процесса - данные остаются
+    pid_t pid = fork();
+    if (pid == 0) {
+        Queue c;
+        init(&c, path);
+        for (int i = 0; i < 1000; i++) push(&c, i);
+        abort();  // без destroy и без flush
+    }
+    waitpid(pid, NULL, 0);
+    init(&q, path);
+    long long sum = 0;
+    long long n = size(&q);
+    while (pop(&q, &val)) sum += val;
+    printf("\nТест 2: после падения писателя: %lld элементов, сумма %lld\n",
+           n, sum); // 1000, 499500
+
+    // Тест 3: Второй процесс не может открыть занятую очередь
+    Queue other;
+    printf("Тест 3: повторное открытие: %s\n",
+           initWith(&other, path, 0) ? "открыто" : "занято"); // занято
+    destroy(&q);
+    remove(path);
+
+    // Тест 4: Переход через конец буфера - пачками
+    initWith(&q, path, 4096);  // 1024 int
+    int in[300], out[300];
+    bool fifo = true;
+    int next = 0, sent = 0;
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 300; i++) in[i] = sent + i;
+        sent += (int)pushBatch(&q, in, 300);
+        size_t k = popBatch(&q, out, 250);
+        for (size_t i = 0; i < k; i++) fifo &= (out[i] == next++);
+    }
+    printf("\nТест 4: FIFO через границу буфера? %s, размер %lld\n",
+           fifo ? "Да" : "Нет", size(&q)); // Да, 774 (заполняется до 1024, минус 250)
+    destroy(&q);
+    remove(path);
+
+    // Тест 5: Скорость
+    initWith(&q, path, 1 << 20);
+    int ops = 50000000;
+    double t0 = now();
+    for (int i = 0; i < ops; i++) {
+        push(&q, i);
+        pop(&q, &val);
+    }
+    printf("\nТест 5: push+pop: %.1f млн/с\n", ops / (now() - t0) / 1e6);
+    destroy(&q);
+    remove(path);
+    return 0;
+}
+*/
@@ -0,0 +1,419 @@
+// Ограниченная очередь "много писателей - много читателей" без блокировок
+// Алгоритм Вьюкова: кольцевой буфер, у каждой ячейки - номер поколения
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <sched.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+typedef void* T;
+
+/* ============================================================
+   ШПАРГАЛКА: MPMC-очередь Вьюкова (Queue MPMC)
+   ============================================================
+   typedef struct {
+       atomic_size_t seq;    // номер поколения ячейки
+       T data;               // элемент
+   } MPMCCell;
+   typedef struct {
+       MPMCCell* cells;      // кольцевой буфер, вместимость - 2^k
+       size_t mask;          // capacity - 1
+       atomic_size_t tail;   // следующая позиция записи (своя строка кэша)
+       atomic_size_t head;   // следующая позиция чтения (своя строка кэша)
+       MPMCParking notEmpty; // здесь спят читатели (счётчик событий)
+       MPMCParking notFull;  // здесь спят писатели
+   } QueueMPMC;
+   ФУНКЦИИ:
+   bool MPMC_Create(QueueMPMC* q, size_t capacity)   N → Queue
+   void MPMC_Destroy(QueueMPMC* q)                   Queue → ∅
+   size_t MPMC_Size(QueueMPMC* q)                    Queue → N
+   bool MPMC_TryPush(QueueMPMC* q, T t)              Queue × T → Queue
+   bool MPMC_TryPop(QueueMPMC* q, T* out)            Queue → Queue × T
+   void MPMC_Push(QueueMPMC* q, T t)                 ждёт, пока есть место
+   T MPMC_Pop(QueueMPMC* q)                          ждёт, пока есть элемент
+   ============================================================
+
+   ИДЕЯ (раскладка - как у QueueArray, но вместо size - поколения):
+     Ячейка i хранит seq - "чья сейчас очередь":
+       seq == pos        → свободна для писателя с позицией pos
+       seq == pos + 1    → заполнена, её ждёт читатель с позицией pos
+     После чтения seq = pos + capacity - ячейка готова для следующего
+     круга писателей
+
+   ЗАПИСЬ (TryPush):
+     1. pos = tail; ячейка = cells[pos & mask]
+     2. seq == pos → CAS(tail: pos → pos + 1) - позиция наша
+        seq <  pos → ячейка ещё не прочитана с прошлого круга: очередь полна
+        seq >  pos → другой писатель опередил, перечитать tail
+     3. data = t; seq = pos + 1 (release) - публикация
+   ЧТЕНИЕ (TryPop) - симметрично, с seq == pos + 1
+
+   - Писатели конкурируют только за tail, читатели - за head
+   - Каждая ячейка публикуется отдельно: медленный писатель не мешает
+     остальным записывать в следующие ячейки
+
+   БЛОКИРУЮЩИЕ ВАРИАНТЫ:
+     Сначала короткое ожидание с повторами, затем сон на futex.
+     Счётчик событий (event count): младший бит - "кто-то собирается спать".
+       спящий:  взвести бит → ещё одна попытка → futex_wait(event)
+       будящий: бит взведён → снять бит, сменить счётчик → futex_wake(всех)
+     Будящий делает системный вызов один раз на засыпание, а не на каждую
+     операцию; пока никто не спит, Push/Pop обходятся без ядра
+*/
+
+#define CACHE_LINE 64
+
+// Сколько раз повторить попытку, прежде чем заснуть
+// (вторую половину попыток - уступая процессор другим потокам)
+#define MPMC_SPIN 64
+
+typedef struct {
+    atomic_size_t seq;
+    T data;
+} MPMCCell;
+
+// Место для сна: счётчик событий (его ждёт futex)
+// Бит 0 - есть спящие, остальные биты меняются при каждом пробуждении
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_uint event;
+} MPMCParking;
+
+typedef struct {
+    _Alignas(CACHE_LINE) MPMCCell* cells;
+    size_t mask;
+
+    _Alignas(CACHE_LINE) atomic_size_t tail;
+    _Alignas(CACHE_LINE) atomic_size_t head;
+
+    MPMCParking notEmpty;
+    MPMCParking notFull;
+} QueueMPMC;
+
+// ============ FUTEX ============
+
+// Заснуть, если event всё ещё равен expected
+static void mpmcFutexWait(atomic_uint* event, unsigned expected) {
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned*)event, FUTEX_WAIT_PRIVATE, expected,
+            NULL, NULL, 0);
+#else
+    (void)event; (void)expected;
+    sched_yield();  // без futex - просто уступаем процессор
+#endif
+}
+
+static void mpmcFutexWakeAll(atomic_uint* event) {
+#ifdef __linux__
+    syscall(SYS_futex, (unsigned*)event, FUTEX_WAKE_PRIVATE, INT32_MAX,
+            NULL, NULL, 0);
+#else
+    (void)event;
+#endif
+}
+
+// Взвести бит "есть спящие"; возвращает значение, на котором спать
+static unsigned mpmcPrepareWait(MPMCParking* p) {
+    unsigned ev = atomic_load_explicit(&p->event, memory_order_relaxed);
+    while (!(ev & 1) &&
+           !atomic_compare_exchange_weak_explicit(&p->event, &ev, ev | 1,
+               memory_order_seq_cst, memory_order_relaxed)) {
+    }
+    atomic_thread_fence(memory_order_seq_cst);
+    return ev | 1;
+}
+
+// Разбудить спящих, если такие есть
+static void mpmcNotify(MPMCParking* p) {
+    // Барьер в паре с mpmcPrepareWait: либо мы видим взведённый бит,
+    // либо спящий после взведения увидит наш элемент/место
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned ev = atomic_load_explicit(&p->event, memory_order_relaxed);
+    if ((ev & 1) &&
+        atomic_compare_exchange_strong_explicit(&p->event, &ev, ev + 1,
+            memory_order_relaxed, memory_order_relaxed)) {
+        mpmcFutexWakeAll(&p->event);  // ev + 1: бит снят, счётчик сменился
+    }
+}
+
+// ============ ОСНОВНЫЕ ФУНКЦИИ ============
+
+// Вместимость округляется вверх до степени двойки
+bool MPMC_Create(QueueMPMC* q, size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    q->cells = malloc(sizeof(MPMCCell) * cap);
+    if (!q->cells) return false;
+    q->mask = cap - 1;
+    for (size_t i = 0; i < cap; i++) {
+        atomic_init(&q->cells[i].seq, i);  // ячейка i ждёт писателя с позицией i
+    }
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->head, 0);
+    atomic_init(&q->notEmpty.event, 0);
+    atomic_init(&q->notFull.event, 0);
+    return true;
+}
+
+void MPMC_Destroy(QueueMPMC* q) {
+    free(q->cells);
+    q->cells = NULL;
+}
+
+// Приблизительный размер (мгновенный снимок)
+size_t MPMC_Size(QueueMPMC* q) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return (tail > head) ? tail - head : 0;
+}
+
+// Попытка записи; false - очередь полна
+static bool mpmcTryPush(QueueMPMC* q, T t) {
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    MPMCCell* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            // при неудаче CAS сам запишет в pos новое значение tail
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+    cell->data = t;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+// Попытка чтения; false - очередь пуста
+static bool mpmcTryPop(QueueMPMC* q, T* out) {
+    size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    MPMCCell* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+    }
+    *out = cell->data;
+    // Ячейка свободна для писателя следующего круга
+    atomic_store_explicit(&cell->seq, pos + q->mask + 1, memory_order_release);
+    return true;
+}
+
+bool MPMC_TryPush(QueueMPMC* q, T t) {
+    if (!mpmcTryPush(q, t)) return false;
+    mpmcNotify(&q->notEmpty);
+    return true;
+}
+
+bool MPMC_TryPop(QueueMPMC* q, T* out) {
+    if (!mpmcTryPop(q, out)) return false;
+    mpmcNotify(&q->notFull);
+    return true;
+}
+
+// ============ БЛОКИРУЮЩИЕ ФУНКЦИИ ============
+
+// Записать, при необходимости дождавшись места
+void MPMC_Push(QueueMPMC* q, T t) {
+    for (int i = 0; i < MPMC_SPIN; i++) {
+        if (MPMC_TryPush(q, t)) return;
+        if (i >= MPMC_SPIN / 2) sched_yield();
+    }
+    for (;;) {
+        // Взводим бит ДО последней попытки - иначе можно пропустить
+        // освобождение места между попыткой и сном
+        unsigned ev = mpmcPrepareWait(&q->notFull);
+        if (mpmcTryPush(q, t)) {
+            mpmcNotify(&q->notEmpty);
+            return;
+        }
+        mpmcFutexWait(&q->notFull.event, ev);
+    }
+}
+
+// Прочитать, при необходимости дождавшись элемента
+T MPMC_Pop(QueueMPMC* q) {
+    T t;
+    for (int i = 0; i < MPMC_SPIN; i++) {
+        if (MPMC_TryPop(q, &t)) return t;
+        if (i >= MPMC_SPIN / 2) sched_yield();
+    }
+    for (;;) {
+        unsigned ev = mpmcPrepareWait(&q->notEmpty);
+        if (mpmcTryPop(q, &t)) {
+            mpmcNotify(&q->notFull);
+            return t;
+        }
+        mpmcFutexWait(&q->notEmpty.event, ev);
+    }
+}
+
+// ============ СЛОЖНОСТЬ ============
+// MPMC_Create: O(capacity) - разметка поколений
+// MPMC_TryPush / MPMC_TryPop: O(1) без блокировок; при конкуренции
+//                             CAS может повторяться (lock-free, не wait-free)
+// MPMC_Push / MPMC_Pop: O(1) + ожидание; системный вызов - только
+//                       если кто-то действительно спит или надо заснуть
+// Память: O(capacity) ячеек + несколько строк кэша
+//
+// Сравнение с очередью под мьютексом:
+// - Мьютекс сериализует ВСЕ операции; QueueDynamic ещё и делает
+//   malloc/free на каждый элемент
+// - Здесь писатели и читатели не мешают друг другу (разные счётчики),
+//   а внутри группы конфликт - один CAS
+// - Ограниченность: при переполнении писатель ждёт (естественное
+//   противодавление для пула потоков)
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+#include "queue_dyn.c"
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#define TASKS 2000000L
+#define STOP ((void*)-1)
+
+QueueMPMC mq;
+
+// Очередь для сравнения: QueueDynamic под мьютексом и условными переменными
+QueueDynamic dq;
+pthread_mutex_t dqLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t dqNotEmpty = PTHREAD_COND_INITIALIZER;
+
+typedef struct { long from, to; } Range;
+atomic_llong total;
+
+void* mpmcProducer(void* arg) {
+    Range* r = arg;
+    for (long i = r->from; i < r->to; i++) MPMC_Push(&mq, (void*)(i + 1));
+    return NULL;
+}
+
+void* mpmcConsumer(void* arg) {
+    (void)arg;
+    long long sum = 0;
+    for (T t; (t = MPMC_Pop(&mq)) != STOP;) sum += (long)t;
+    atomic_fetch_add(&total, sum);
+    return NULL;
+}
+
+void* mutexProducer(void* arg) {
+    Range* r = arg;
+    for (long i = r->from; i < r->to; i++) {
+        pthread_mutex_lock(&dqLock);
+        QD_Push(&dq, (void*)(i + 1));
+        pthread_cond_signal(&dqNotEmpty);
+        pthread_mutex_unlock(&dqLock);
+    }
+    return NULL;
+}
+
+void* mutexConsumer(void* arg) {
+    (void)arg;
+    long long sum = 0;
+    for (;;) {
+        pthread_mutex_lock(&dqLock);
+        while (QD_Empty(&dq)) pthread_cond_wait(&dqNotEmpty, &dqLock);
+        T t = QD_Top(&dq);
+        QD_Pop(&dq);
+        pthread_mutex_unlock(&dqLock);
+        if (t == STOP) break;
+        sum += (long)t;
+    }
+    atomic_fetch_add(&total, sum);
+    return NULL;
+}
+
+// threads писателей и threads читателей; возвращает млн задач/с
+double run(int threads, bool lockFree) {
+    pthread_t prod[64], cons[64];
+    Range ranges[64];
+    atomic_store(&total, 0);
+    double t0 = now();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&cons[i], NULL, lockFree ? mpmcConsumer : mutexConsumer, NULL);
+    }
+    for (int i = 0; i < threads; i++) {
+        ranges[i].from = TASKS * i / threads;
+        ranges[i].to = TASKS * (i + 1) / threads;
+        pthread_create(&prod[i], NULL, lockFree ? mpmcProducer : mutexProducer, &ranges[i]);
+    }
+    for (int i = 0; i < threads; i++) pthread_join(prod[i], NULL);
+    for (int i = 0; i < threads; i++) {  // по сигналу остановки на читателя
+        if (lockFree) {
+            MPMC_Push(&mq, STOP);
+        } else {
+            pthread_mutex_lock(&dqLock);
+            QD_Push(&dq, STOP);
+            pthread_cond_signal(&dqNotEmpty);
+            pthread_mutex_unlock(&dqLock);
+        }
+    }
+    for (int i = 0; i < threads; i++) pthread_join(cons[i], NULL);
+    double rate = TASKS / (now() - t0) / 1e6;
+    if (atomic_load(&total) != TASKS * (TASKS + 1) / 2) printf("ОШИБКА: сумма не сошлась\n");
+    return rate;
+}
+
+int main() {
+    printf("=== MPMC-очередь Вьюкова ===\n\n");
+
+    // Тест 1: Однопоточно - FIFO и переполнение
+    MPMC_Create(&mq, 4);
+    int pushed = 0;
+    for (long i = 1; i <= 6; i++) pushed += MPMC_TryPush(&mq, (void*)i);
+    T t;
+    printf("Тест 1: добавлено %d из 6, порядок: ", pushed); // 4
+    while (MPMC_TryPop(&mq, &t)) printf("%ld ", (long)t);  // 1 2 3 4
+    printf("\nПуста? %s\n\n", MPMC_Size(&mq) == 0 ? "Да" : "Нет");
+    MPMC_Destroy(&mq);
+
+    // Тест 2: Масштабирование - писатели = читатели = 1..64
+    MPMC_Create(&mq, 1024);
+    QD_Create(&dq);
+    printf("Тест 2: %ld задач, млн задач/с\n", TASKS);
+    printf("потоки  MPMC   мьютекс+QueueDynamic\n");
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        double a = run(threads, true);
+        double b = run(threads, false);
+        printf("%2d+%-2d  %6.1f  %6.1f\n", threads, threads, a, b);
+    }
+
+    MPMC_Destroy(&mq);
+    QD_Destroy(&dq);
+    return 0;
+}
+*/
@@ -0,0 +1,346 @@
+// Очередь "один писатель - один читатель" без блокировок (SPSC ring buffer)
+// Кольцевой буфер QueueArray, который можно делить между двумя потоками
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+
+typedef void* T;
+
+/* ============================================================
+   ШПАРГАЛКА: SPSC-очередь на кольцевом буфере (Queue SPSC)
+   ============================================================
+   typedef struct {
+       // строка кэша писателя
+       atomic_size_t tail;   // сколько элементов записано за всё время
+       size_t headCache;     // последний прочитанный писателем head
+       // строка кэша читателя
+       atomic_size_t head;   // сколько элементов прочитано за всё время
+       size_t tailCache;     // последний прочитанный читателем tail
+       // общие поля (только чтение)
+       T* data;              // буфер, вместимость - степень двойки
+       size_t mask;          // capacity - 1
+   } QueueSPSC;
+   ФУНКЦИИ:
+   bool SPSC_Create(QueueSPSC* q, size_t capacity)   N → Queue
+   void SPSC_Destroy(QueueSPSC* q)                   Queue → ∅
+   bool SPSC_Empty(QueueSPSC* q)                     Queue → boolean
+   size_t SPSC_Size(QueueSPSC* q)                    Queue → N
+   --- только писатель ---
+   bool SPSC_Push(QueueSPSC* q, T t)                 Queue × T → Queue
+   size_t SPSC_PushN(QueueSPSC* q, const T* src, size_t n)
+   --- только читатель ---
+   bool SPSC_Pop(QueueSPSC* q, T* out)               Queue → Queue × T
+   size_t SPSC_PopN(QueueSPSC* q, T* dst, size_t n)
+   ============================================================
+
+   ОТЛИЧИЯ ОТ QueueArray (queue_mass.c):
+   1. Вместимость - степень двойки: индекс = i & mask вместо i % N
+      (деление - десятки тактов, AND - один)
+   2. head и tail - счётчики, которые только растут:
+        размер = tail - head, полна ⟺ tail - head == capacity
+      Поле size не нужно - его пришлось бы менять обоим потокам
+   3. tail меняет только писатель, head - только читатель →
+      достаточно атомарных load/store, без мьютекса и CAS
+   4. Порядок памяти:
+        писатель: data[tail] = t;  store(tail + 1, release)
+        читатель: load(tail, acquire) → видит и новый tail, и data
+   5. head и tail - в разных строках кэша (64 байта): иначе каждая
+      запись одного потока выбивала бы строку из кэша другого
+      (ложное разделение, false sharing)
+   6. headCache / tailCache: писатель перечитывает настоящий head только
+      когда по кэшированному значению очередь полна (читатель - наоборот).
+      Обычно обмен строками кэша - раз на много операций
+   7. PushN / PopN: одна публикация tail/head на пачку элементов
+*/
+
+#define CACHE_LINE 64
+
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_size_t tail;
+    size_t headCache;
+
+    _Alignas(CACHE_LINE) atomic_size_t head;
+    size_t tailCache;
+
+    _Alignas(CACHE_LINE) T* data;
+    size_t mask;
+} QueueSPSC;
+
+// Вместимость округляется вверх до степени двойки
+bool SPSC_Create(QueueSPSC* q, size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    q->data = malloc(sizeof(T) * cap);
+    if (!q->data) return false;
+    q->mask = cap - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->headCache = 0;
+    q->tailCache = 0;
+    return true;
+}
+
+void SPSC_Destroy(QueueSPSC* q) {
+    free(q->data);
+    q->data = NULL;
+}
+
+// Размер и пустота - мгновенный снимок: другой поток может
+// тут же его изменить
+size_t SPSC_Size(QueueSPSC* q) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    return tail - head;
+}
+
+bool SPSC_Empty(QueueSPSC* q) { return SPSC_Size(q) == 0; }
+
+// ============ ПИСАТЕЛЬ ============
+
+// Сколько свободных мест видит писатель (не меньше want, если возможно)
+static size_t spscFree(QueueSPSC* q, size_t tail, size_t want) {
+    size_t cap = q->mask + 1;
+    size_t free_ = cap - (tail - q->headCache);
+    if (free_ < want) {
+        q->headCache = atomic_load_explicit(&q->head, memory_order_acquire);
+        free_ = cap - (tail - q->headCache);
+    }
+    return free_;
+}
+
+bool SPSC_Push(QueueSPSC* q, T t) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (spscFree(q, tail, 1) == 0) return false;  // переполнение
+    q->data[tail & q->mask] = t;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// Записать до n элементов; возвращает, сколько поместилось
+size_t SPSC_PushN(QueueSPSC* q, const T* src, size_t n) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t free_ = spscFree(q, tail, n);
+    if (n > free_) n = free_;
+    if (n == 0) return 0;
+
+    // Пачка может перейти через конец буфера - два куска
+    size_t at = tail & q->mask;
+    size_t first = q->mask + 1 - at;
+    if (first > n) first = n;
+    memcpy(q->data + at, src, sizeof(T) * first);
+    memcpy(q->data, src + first, sizeof(T) * (n - first));
+
+    atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+    return n;
+}
+
+// ============ ЧИТАТЕЛЬ ============
+
+// Сколько элементов видит читатель (не меньше want, если возможно)
+static size_t spscAvailable(QueueSPSC* q, size_t head, size_t want) {
+    size_t avail = q->tailCache - head;
+    if (avail < want) {
+        q->tailCache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        avail = q->tailCache - head;
+    }
+    return avail;
+}
+
+bool SPSC_Pop(QueueSPSC* q, T* out) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (spscAvailable(q, head, 1) == 0) return false;  // пусто
+    *out = q->data[head & q->mask];
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return true;
+}
+
+// Прочитать до n элементов; возвращает, сколько прочитано
+size_t SPSC_PopN(QueueSPSC* q, T* dst, size_t n) {
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t avail = spscAvailable(q, head, n);
+    if (n > avail) n = avail;
+    if (n == 0) return 0;
+
+    size_t at = head & q->mask;
+    size_t first = q->mask + 1 - at;
+    if (first > n) first = n;
+    memcpy(dst, q->data + at, sizeof(T) * first);
+    memcpy(dst + first, q->data, sizeof(T) * (n - first));
+
+    atomic_store_explicit(&q->head, head + n, memory_order_release);
+    return n;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// SPSC_Create: O(capacity) - выделение буфера
+// SPSC_Push / SPSC_Pop: O(1), без блокировок и без CAS
+// SPSC_PushN / SPSC_PopN: O(n) - два memcpy и одна публикация индекса
+// SPSC_Size / SPSC_Empty: O(1), значение приблизительное
+// Память: O(capacity) + 3 строки кэша
+//
+// Ограничения:
+// - Ровно ОДИН поток пишет и ОДИН читает. Два писателя испортят tail -
+//   для нескольких нужна MPMC-очередь
+// - Ожидание (очередь пуста/полна) - забота вызывающего: повторить,
+//   уступить процессор (sched_yield) или заснуть
+//
+// Почему быстрее мьютекса:
+// - Мьютекс: захват/освобождение - атомарные RMW-операции на общей
+//   строке кэша при КАЖДОЙ операции, плюс засыпание в ядре при конфликте
+// - SPSC: обычные load/store, строки кэша переходят между ядрами
+//   только когда кэшированный индекс "устарел"
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#define ITEMS 10000000L
+#define BATCH 64
+#define ROUNDS 100000
+
+QueueSPSC ping, pong;
+QueueSPSC stream;
+
+// Эхо: вернуть каждый элемент обратно
+void* echo(void* arg) {
+    (void)arg;
+    T t;
+    for (long i = 0; i < ROUNDS; i++) {
+        while (!SPSC_Pop(&ping, &t)) sched_yield();
+        while (!SPSC_Push(&pong, t)) sched_yield();
+    }
+    return NULL;
+}
+
+void* consumer(void* arg) {
+    long batch = (long)arg;
+    long long sum = 0;
+    T buf[BATCH];
+    for (long got = 0; got < ITEMS;) {
+        size_t k = (batch > 1) ? SPSC_PopN(&stream, buf, BATCH)
+                               : SPSC_Pop(&stream, buf);
+        if (k == 0) { sched_yield(); continue; }
+        for (size_t i = 0; i < k; i++) sum += (long)buf[i];
+        got += (long)k;
+    }
+    return (void*)(long)(sum == ITEMS * (ITEMS - 1) / 2);
+}
+
+// Для сравнения: тот же кольцевой буфер под мьютексом
+typedef struct {
+    T data[1024];
+    int head, size;
+    pthread_mutex_t lock;
+} MutexQueue;
+MutexQueue mq = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+void* mutexConsumer(void* arg) {
+    (void)arg;
+    long long sum = 0;
+    for (long got = 0; got < ITEMS;) {
+        pthread_mutex_lock(&mq.lock);
+        bool ok = mq.size > 0;
+        if (ok) {
+            sum += (long)mq.data[mq.head];
+            mq.head = (mq.head + 1) % 1024;
+            mq.size--;
+        }
+        pthread_mutex_unlock(&mq.lock);
+        if (ok) got++; else sched_yield();
+    }
+    return (void*)(long)(sum == ITEMS * (ITEMS - 1) / 2);
+}
+
+int main() {
+    printf("=== SPSC-очередь без блокировок ===\n\n");
+
+    // Тест 1: FIFO в одном потоке, переполнение, переход через конец
+    QueueSPSC q;
+    SPSC_Create(&q, 5);  // → 8
+    int pushed = 0;
+    for (long i = 0; i < 10; i++) pushed += SPSC_Push(&q, (void*)i);
+    printf("Тест 1: вместимость %zu, добавлено %d из 10\n", q.mask + 1, pushed); // 8, 8
+    T out[8];
+    size_t k = SPSC_PopN(&q, out, 5);
+    T more[4] = {(void*)100, (void*)200, (void*)300, (void*)400};
+    SPSC_PushN(&q, more, 4);
+    k = SPSC_PopN(&q, out, 8);
+    printf("После PopN(5) + PushN(4): ");
+    for (size_t i = 0; i < k; i++) printf("%ld ", (long)out[i]);
+    printf("\n\n"); // 5 6 7 100 200 300 400
+    SPSC_Destroy(&q);
+
+    // Тест 2: Задержка "туда-обратно" (ping-pong)
+    SPSC_Create(&ping, 64);
+    SPSC_Create(&pong, 64);
+    pthread_t th;
+    pthread_create(&th, NULL, echo, NULL);
+    double t0 = now();
+    T t;
+    for (long i = 0; i < ROUNDS; i++) {
+        while (!SPSC_Push(&ping, (void*)i)) sched_yield();
+        while (!SPSC_Pop(&pong, &t)) sched_yield();
+    }
+    double rtt = (now() - t0) / ROUNDS;
+    pthread_join(th, NULL);
+    printf("Тест 2: ping-pong, %d обменов: %.0f нс туда-обратно\n\n",
+           ROUNDS, rtt * 1e9);
+
+    // Тест 3: Пропускная способность - поштучно, пачками, под мьютексом
+    SPSC_Create(&stream, 1024);
+    printf("Тест 3: пропускная способность, %ld элементов\n", ITEMS);
+    for (long batch = 1; batch <= BATCH; batch += BATCH - 1) {
+        void* ok;
+        pthread_create(&th, NULL, consumer, (void*)batch);
+        t0 = now();
+        T buf[BATCH];
+        for (long sent = 0; sent < ITEMS;) {
+            long want = (batch > 1 && ITEMS - sent >= BATCH) ? BATCH : 1;
+            for (long i = 0; i < want; i++) buf[i] = (void*)(sent + i);
+            size_t put = (want > 1) ? SPSC_PushN(&stream, buf, (size_t)want)
+                                    : SPSC_Push(&stream, buf[0]);
+            if (put == 0) sched_yield();
+            sent += (long)put;
+        }
+        pthread_join(th, &ok);
+        printf("SPSC, пачка %2ld: %6.1f млн/с %s\n", batch,
+               ITEMS / (now() - t0) / 1e6, ok ? "" : "(ОШИБКА)");
+    }
+
+    void* ok;
+    pthread_create(&th, NULL, mutexConsumer, NULL);
+    t0 = now();
+    for (long sent = 0; sent < ITEMS;) {
+        pthread_mutex_lock(&mq.lock);
+        bool room = mq.size < 1024;
+        if (room) {
+            mq.data[(mq.head + mq.size) % 1024] = (void*)sent;
+            mq.size++;
+        }
+        pthread_mutex_unlock(&mq.lock);
+        if (room) sent++; else sched_yield();
+    }
+    pthread_join(th, &ok);
+    printf("Мьютекс:       %6.1f млн/с %s\n",
+           ITEMS / (now() - t0) / 1e6, ok ? "" : "(ОШИБКА)");
+
+    SPSC_Destroy(&ping);
+    SPSC_Destroy(&pong);
+    SPSC_Destroy(&stream);
+    return 0;
+}
+*/
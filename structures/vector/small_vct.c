@@ -0,0 +1,325 @@
+// Вектор с малым буфером (Small Vector)
+// Первые SMALL_VECTOR_INLINE элементов хранятся прямо в структуре,
+// куча используется только когда их становится больше
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef void* T;
+
+// Сколько элементов помещается без malloc
+#define SMALL_VECTOR_INLINE 8
+
+/* ============================================================
+   ШПАРГАЛКА: Вектор с малым буфером (Small Vector)
+   ============================================================
+   СТРУКТУРА:
+   typedef struct {
+       int size;                  // размер вектора
+       int capacity;              // == SMALL_VECTOR_INLINE → элементы внутри
+       union {
+           T local[SMALL_VECTOR_INLINE];  // встроенный буфер
+           T* heap;                       // массив в куче (capacity > N)
+       } items;
+   } SmallVector
+   ФУНКЦИИ (те же, что у Vector из vct.c):
+   void Create(SmallVector* v, int sz)          N → V_T,In
+   bool Empty(SmallVector* v)                   V_T,In → boolean
+   int Size(SmallVector* v)                     V_T,In → N
+   T Load(SmallVector* v, int i)                V_T,In × In → T
+   void Save(SmallVector* v, int i, T t)        V_T,In × In × T → V_T,In
+   void Resize(SmallVector* v, int sz)          V_T,In × N → V_T,Im
+   bool Equal(SmallVector* l, SmallVector* r)   V_T,In × V_T,In → boolean
+   void Destroy(SmallVector* v)                 V_T,In → ∅
+   void PushBack(SmallVector* v, T t)           V_T,In × T → V_T,In+1
+   void PopBack(SmallVector* v)                 V_T,In → V_T,In-1
+   void Reserve(SmallVector* v, int cap)        V_T,In × N → V_T,In
+   void ShrinkToFit(SmallVector* v)             V_T,In → V_T,In
+   void Append(SmallVector* v, const T* src, int n)  V_T,In × T^m → V_T,In+m
+   void Copy(SmallVector* dst, SmallVector* src)     V_T,In → V_T,In × V_T,In
+   void Move(SmallVector* dst, SmallVector* src)     V_T,In → V_T,In × V_T,I0
+   ============================================================
+
+   РАСКЛАДКА:
+     size ≤ 8:  [size|cap=8| e0 e1 e2 ... e7 ]   ← всё в структуре
+     size > 8:  [size|cap  | heap ──────────]──→ [e0 e1 ... e_cap-1]
+
+   - local и heap делят память (union): буфер ничего не стоит,
+     когда элементы переехали в кучу
+   - Короткий вектор (путь в графе, дети узла дерева) живёт целиком
+     на стеке или внутри другой структуры: ни одного malloc/free
+   - НЕ КОПИРУЙТЕ СТРУКТУРУ ПРИСВАИВАНИЕМ (SmallVector b = a): у длинного
+     вектора копия разделит с оригиналом указатель heap, и Destroy обеих
+     освободит его дважды. Переход в кучу происходит незаметно, при
+     очередном PushBack, поэтому и короткий вектор копировать так нельзя
+       Copy(&b, &a)  - независимая копия (своя куча, если она нужна)
+       Move(&b, &a)  - забрать содержимое за O(1), a становится пустым
+*/
+
+typedef struct
+{
+    int size;
+    int capacity;
+    union {
+        T local[SMALL_VECTOR_INLINE];
+        T* heap;
+    } items;
+} SmallVector;
+
+// Массив элементов: встроенный буфер или куча
+static T* Items(SmallVector* v)
+{
+    return (v->capacity > SMALL_VECTOR_INLINE) ? v->items.heap : v->items.local;
+}
+
+// Сменить вместимость (cap ≥ size); cap ≤ N → вернуться во встроенный буфер
+static void SetCapacity(SmallVector* v, int cap)
+{
+    bool onHeap = v->capacity > SMALL_VECTOR_INLINE;
+    if(cap <= SMALL_VECTOR_INLINE) {
+        if(onHeap) {
+            T* old = v->items.heap;  // local перекрывает heap - сохраняем заранее
+            memcpy(v->items.local, old, sizeof(T) * v->size);
+            free(old);
+        }
+        v->capacity = SMALL_VECTOR_INLINE;
+    } else if(onHeap) {
+        v->items.heap = realloc(v->items.heap, sizeof(T) * cap);
+        v->capacity = cap;
+    } else {
+        T* p = malloc(sizeof(T) * cap);
+        memcpy(p, v->items.local, sizeof(T) * v->size);
+        v->items.heap = p;
+        v->capacity = cap;
+    }
+}
+
+// Место хотя бы под need элементов, рост вдвое
+static void Grow(SmallVector* v, int need)
+{
+    if(need <= v->capacity)
+        return;
+    int cap = v->capacity * 2;
+    if(cap < need)
+        cap = need;
+    SetCapacity(v, cap);
+}
+
+void Create(SmallVector* v, int sz)
+{
+    v->size = sz;
+    if(sz <= SMALL_VECTOR_INLINE) {
+        v->capacity = SMALL_VECTOR_INLINE;
+        memset(v->items.local, 0, sizeof(v->items.local));
+    } else {
+        v->capacity = sz;
+        v->items.heap = calloc(sz, sizeof(T));
+    }
+}
+
+bool Empty(SmallVector* v)
+{
+    return v->size == 0;
+}
+
+int Size(SmallVector* v)
+{
+    return v->size;
+}
+
+T Load(SmallVector* v, int i)
+{
+    if((i >= 0) && (i < v->size))
+        return Items(v)[i];
+    return NULL;
+}
+
+void Save(SmallVector* v, int i, T t)
+{
+    if((i >= 0) && (i < v->size))
+        Items(v)[i] = t;
+}
+
+// Изменить размер: новые элементы = NULL, вместимость не уменьшается
+void Resize(SmallVector* v, int sz)
+{
+    Grow(v, sz);
+    if(sz > v->size)
+        memset(Items(v) + v->size, 0, sizeof(T) * (sz - v->size));
+    v->size = sz;
+}
+
+bool Equal(SmallVector* l, SmallVector* r)
+{
+    if(l->size != r->size)
+        return false;
+    T* a = Items(l);
+    T* b = Items(r);
+    for(int i = 0; i < l->size; i++)
+        if(a[i] != b[i])
+            return false;
+    return true;
+}
+
+void Destroy(SmallVector* v)
+{
+    if(v->capacity > SMALL_VECTOR_INLINE)
+        free(v->items.heap);
+    v->size = 0;
+    v->capacity = SMALL_VECTOR_INLINE;
+}
+
+// ============ РОСТ ============
+
+void PushBack(SmallVector* v, T t)
+{
+    Grow(v, v->size + 1);
+    Items(v)[v->size++] = t;
+}
+
+void PopBack(SmallVector* v)
+{
+    if(v->size)
+        v->size--;
+}
+
+void Reserve(SmallVector* v, int cap)
+{
+    if(cap > v->capacity)
+        SetCapacity(v, cap);
+}
+
+// Вернуть лишнюю память; короткий вектор возвращается во встроенный буфер
+void ShrinkToFit(SmallVector* v)
+{
+    if(v->capacity > v->size && v->capacity > SMALL_VECTOR_INLINE)
+        SetCapacity(v, v->size);
+}
+
+// src может указывать в сам вектор: при росте элементы переезжают
+// (realloc или из встроенного буфера в кучу), поэтому такой src
+// пересчитывается по смещению. Диапазон src[0..n) - внутри [0, size)
+void Append(SmallVector* v, const T* src, int n)
+{
+    if(n <= 0)
+        return;
+    uintptr_t s = (uintptr_t)src;
+    uintptr_t b = (uintptr_t)Items(v);
+    bool inside = s >= b && s < b + sizeof(T) * v->size;
+    size_t offset = inside ? (s - b) / sizeof(T) : 0;
+    Grow(v, v->size + n);
+    if(inside)
+        src = Items(v) + offset;
+    memcpy(Items(v) + v->size, src, sizeof(T) * n);
+    v->size += n;
+}
+
+// ============ КОПИРОВАНИЕ И ПЕРЕМЕЩЕНИЕ ============
+
+// Независимая копия src в dst (dst - не созданный или уничтоженный вектор)
+void Copy(SmallVector* dst, SmallVector* src)
+{
+    Create(dst, 0);
+    Append(dst, Items(src), src->size);
+}
+
+// Перенести содержимое src в dst за O(1); src остаётся пустым вектором
+// (dst - не созданный или уничтоженный вектор)
+void Move(SmallVector* dst, SmallVector* src)
+{
+    *dst = *src;
+    src->size = 0;
+    src->capacity = SMALL_VECTOR_INLINE;
+}
+
+// ============ СЛОЖНОСТЬ ============
+// Те же, что у vct.c, но:
+// Create / Destroy: O(1) без malloc/free, пока size ≤ SMALL_VECTOR_INLINE
+// Переход в кучу: O(N) - один раз, при росте за N элементов
+// Load / Save: O(1) + одна проверка "внутри или в куче"
+// Copy: O(n), Move: O(1)
+// Память: sizeof(SmallVector) = 8 + 8·N байт (72 при N = 8),
+//         в куче - только у длинных векторов
+//
+// Когда использовать:
+// - Много короткоживущих векторов, обычно короче N (пути, списки детей,
+//   соседи вершины): malloc/free исчезают из профиля
+// - Почти всегда длинные векторы → обычный Vector: буфер лишь
+//   увеличивает структуру
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <time.h>
+
+int main() {
+    printf("=== Вектор с малым буфером ===\n\n");
+
+    // Тест 1: Короткий вектор - без кучи
+    SmallVector v;
+    Create(&v, 0);
+    for (long i = 1; i <= 5; i++)
+        PushBack(&v, (void*)(i * 10));
+    printf("Тест 1: size=%d, capacity=%d, v[4]=%ld\n",
+           Size(&v), v.capacity, (long)Load(&v, 4)); // 5, 8, 50
+
+    // Тест 2: Рост за пределы буфера и возврат обратно
+    for (long i = 6; i <= 20; i++)
+        PushBack(&v, (void*)(i * 10));
+    printf("Тест 2: size=%d, capacity=%d, v[19]=%ld\n",
+           Size(&v), v.capacity, (long)Load(&v, 19)); // 20, 32, 200
+    Resize(&v, 3);
+    ShrinkToFit(&v);
+    printf("После Resize(3) + ShrinkToFit: capacity=%d, v[2]=%ld\n",
+           v.capacity, (long)Load(&v, 2)); // 8, 30
+
+    // Тест 3: Copy - независимая копия, Move - перенос без копирования
+    SmallVector copy, moved;
+    Copy(&copy, &v);
+    Save(&copy, 0, (void*)99);
+    printf("Тест 3: v[0]=%ld, copy[0]=%ld, равны? %s\n",
+           (long)Load(&v, 0), (long)Load(&copy, 0),
+           Equal(&v, &copy) ? "Да" : "Нет"); // 10, 99, Нет
+    for (long i = 0; i < 20; i++)
+        PushBack(&copy, (void*)i);                  // copy - в куче
+    Move(&moved, &copy);
+    printf("После Move: moved size=%d, copy size=%d\n",
+           Size(&moved), Size(&copy)); // 23, 0
+    Destroy(&copy);                                 // безопасно: copy пуст
+    Destroy(&moved);
+    Destroy(&v);
+
+    // Тест 4: Много коротких векторов: встроенный буфер против malloc
+    int rounds = 5000000;
+    long long sum = 0;
+    clock_t t0 = clock();
+    for (int r = 0; r < rounds; r++) {
+        T* heap = malloc(sizeof(T) * SMALL_VECTOR_INLINE);  // как Vector из vct.c
+        for (int i = 0; i < 6; i++)
+            heap[i] = (void*)(long)(r + i);
+        sum += (long)heap[r % 6];
+        free(heap);
+    }
+    double tHeap = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    for (int r = 0; r < rounds; r++) {
+        SmallVector s;
+        Create(&s, 0);
+        for (int i = 0; i < 6; i++)
+            PushBack(&s, (void*)(long)(r + i));
+        sum -= (long)Load(&s, r % 6);
+        Destroy(&s);
+    }
+    double tSmall = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("Тест 4: %d векторов по 6 элементов\n", rounds);
+    printf("malloc/free:      %.3f с\n", tHeap);
+    printf("встроенный буфер: %.3f с\n", tSmall);
+    printf("Контрольная сумма: %lld\n", sum); // 0
+
+    return 0;
+}
+*/
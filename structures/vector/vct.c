@@ -1,5 +1,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 typedef void* T;
 
@@ -8,8 +10,9 @@ typedef void* T;
    ============================================================
    СТРУКТУРА:
    typedef struct {
-       T* data;     // массив элементов
-       int size;    // размер вектора
+       T* data;       // массив элементов
+       int size;      // размер вектора (число элементов)
+       int capacity;  // вместимость (под сколько выделена память)
    } Vector
    ФУНКЦИИ:
    void Create(Vector* v, int sz)           N → V_T,In
@@ -20,18 +23,53 @@ typedef void* T;
    void Resize(Vector* v, int sz)           V_T,In × N → V_T,Im
    bool Equal(Vector* l, Vector* r)         V_T,In × V_T,In → boolean
    void Destroy(Vector* v)                  V_T,In → ∅
+   РОСТ:
+   void PushBack(Vector* v, T t)            V_T,In × T → V_T,In+1
+   void PopBack(Vector* v)                  V_T,In → V_T,In-1
+   void Reserve(Vector* v, int cap)         V_T,In × N → V_T,In
+   void ShrinkToFit(Vector* v)              V_T,In → V_T,In
+   void Append(Vector* v, const T* src, int n)  V_T,In × T^m → V_T,In+m
    ============================================================ */
 
+// Начальная вместимость при первом росте пустого вектора
+#define VECTOR_MIN_CAPACITY 8
+
 typedef struct
 {
     T* data;
     int size;
+    int capacity;
 } Vector;
 
+// Перевыделить память ровно под cap элементов
+static void SetCapacity(Vector* v, int cap)
+{
+    if(cap == 0) {
+        free(v->data);
+        v->data = NULL;
+    } else {
+        v->data = realloc(v->data, sizeof(T) * cap);
+    }
+    v->capacity = cap;
+}
+
+// Обеспечить место хотя бы под need элементов
+// Вместимость растёт геометрически (×2): n добавлений стоят O(n) копирований
+static void Grow(Vector* v, int need)
+{
+    if(need <= v->capacity)
+        return;
+    int cap = v->capacity ? v->capacity * 2 : VECTOR_MIN_CAPACITY;
+    if(cap < need)
+        cap = need;
+    SetCapacity(v, cap);
+}
+
 void Create(Vector* v, int sz)
 {
     v->size = sz;
-    v->data = malloc(sizeof(T) * v->size);
+    v->capacity = sz;
+    v->data = (sz > 0) ? calloc(sz, sizeof(T)) : NULL;  // элементы = NULL
 }
 
 bool Empty(Vector* v)
@@ -48,6 +86,7 @@ T Load(Vector* v, int i)
 {
     if((i >= 0) && (i < v->size))
         return v->data[i];
+    return NULL;
 }
 
 void Save(Vector* v, int i, T t)
@@ -56,10 +95,13 @@ void Save(Vector* v, int i, T t)
         v->data[i] = t;
 }
 
+// Изменить размер: новые элементы = NULL, вместимость не уменьшается
 void Resize(Vector* v, int sz)
 {
+    Grow(v, sz);
+    if(sz > v->size)
+        memset(v->data + v->size, 0, sizeof(T) * (sz - v->size));
     v->size = sz;
-    v->data = realloc(v->data, sizeof(T) * v->size);
 }
 
 bool Equal(Vector* l, Vector* r)
@@ -75,19 +117,82 @@ bool Equal(Vector* l, Vector* r)
 void Destroy(Vector* v)
 {
     v->size = 0;
+    v->capacity = 0;
     free(v->data);
+    v->data = NULL;
+}
+
+// ============ РОСТ ============
+
+// Добавить элемент в конец - O(1) амортизированно
+void PushBack(Vector* v, T t)
+{
+    Grow(v, v->size + 1);
+    v->data[v->size++] = t;
+}
+
+// Удалить последний элемент (память не освобождается)
+void PopBack(Vector* v)
+{
+    if(v->size)
+        v->size--;
+}
+
+// Выделить память заранее, если известно, сколько будет элементов
+void Reserve(Vector* v, int cap)
+{
+    if(cap > v->capacity)
+        SetCapacity(v, cap);
+}
+
+// Вернуть лишнюю память: capacity = size
+void ShrinkToFit(Vector* v)
+{
+    if(v->capacity > v->size)
+        SetCapacity(v, v->size);
+}
+
+// Добавить n элементов из массива src одним копированием
+// src может указывать в сам вектор (Append(v, v->data, v->size) удваивает
+// его содержимое): Grow делает realloc, поэтому такой src пересчитывается
+// по смещению. Диапазон src[0..n) должен лежать внутри [0, size)
+void Append(Vector* v, const T* src, int n)
+{
+    if(n <= 0)
+        return;
+    // Сравнение как чисел: < между указателями на разные массивы не определено
+    uintptr_t s = (uintptr_t)src;
+    uintptr_t b = (uintptr_t)v->data;
+    bool inside = v->data && s >= b && s < b + sizeof(T) * v->size;
+    size_t offset = inside ? (s - b) / sizeof(T) : 0;
+    Grow(v, v->size + n);
+    if(inside)
+        src = v->data + offset;
+    memcpy(v->data + v->size, src, sizeof(T) * n);
+    v->size += n;
 }
 
 // ============ СЛОЖНОСТЬ ============
-// Create: O(n) - выделение памяти под n элементов
+// Create: O(n) - выделение и обнуление памяти под n элементов
 // Load: O(1) - доступ по индексу
 // Save: O(1) - запись по индексу
-// Resize: O(n) - перевыделение памяти
+// Resize: O(1) амортизированно на элемент - перевыделение только при
+//         нехватке вместимости
+// PushBack: O(1) амортизированно - вместимость растёт вдвое
+// PopBack: O(1)
+// Reserve / ShrinkToFit: O(n) - перевыделение памяти
+// Append: O(m) - одно копирование memcpy
 // Equal: O(n) - сравнение двух векторов
 // Empty: O(1) - проверка пустоты
 // Size: O(1) - получение размера
 // Destroy: O(1) - освобождение памяти
-// Память: O(n) - непрерывный массив
+// Память: O(capacity), capacity < 2·size после серии PushBack
+//
+// Почему рост вдвое, а не "ровно под размер":
+// - realloc под точный размер на каждое добавление копирует весь массив:
+//   n добавлений = 1 + 2 + ... + n = O(n²) копирований
+// - При росте вдвое элемент копируется в среднем не больше 2 раз:
+//   n + n/2 + n/4 + ... < 2n → O(n) на n добавлений
 
 // ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
 
@@ -127,10 +232,42 @@ int main() {
     printf("Векторы равны? %s\n", Equal(&v1, &v2) ? "Да" : "Нет"); // Нет (разные размеры)
     
     Resize(&v2, 10);
-    printf("После изменения размера равны? %s\n", Equal(&v1, &v2) ? "Да" : "Нет");
+    printf("После изменения размера равны? %s\n", Equal(&v1, &v2) ? "Да" : "Нет");  // Нет (v1[7] = 70)
     
+    // Тест 4: PushBack и рост вместимости
+    printf("\nТест 4: PushBack\n");
+    Vector v3;
+    Create(&v3, 0);
+    int reallocs = 0;
+    for (int i = 0; i < 1000; i++) {
+        int before = v3.capacity;
+        PushBack(&v3, (void*)(long)i);
+        if (v3.capacity != before) reallocs++;
+    }
+    printf("Size=%d, Capacity=%d, перевыделений: %d\n",
+           Size(&v3), v3.capacity, reallocs); // 1000, 1024, 8
+    PopBack(&v3);
+    printf("После PopBack: Size=%d, последний=%ld\n",
+           Size(&v3), (long)Load(&v3, Size(&v3) - 1)); // 999, 998
+
+    // Тест 5: Append, Reserve, ShrinkToFit
+    printf("\nТест 5: Append, Reserve, ShrinkToFit\n");
+    T chunk[3] = {(void*)1, (void*)2, (void*)3};
+    Vector v4;
+    Create(&v4, 0);
+    Reserve(&v4, 100);
+    Append(&v4, chunk, 3);
+    Append(&v4, chunk, 3);
+    printf("Size=%d, Capacity=%d\n", Size(&v4), v4.capacity); // 6, 100
+    ShrinkToFit(&v4);
+    printf("После ShrinkToFit: Capacity=%d, v[4]=%ld\n",
+           v4.capacity, (long)Load(&v4, 4)); // 6, 2
+    printf("Load за границей: %p\n", Load(&v4, 10)); // (nil)
+
     Destroy(&v1);
     Destroy(&v2);
+    Destroy(&v3);
+    Destroy(&v4);
     
     return 0;
 }
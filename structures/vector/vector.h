@@ -0,0 +1,282 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* ============================================================
+   ШПАРГАЛКА: Типизированный вектор (DEF_VECTOR)
+   ============================================================
+   DEF_VECTOR(Name, Type) порождает вектор Name с элементами Type
+   (в духе DEF_LIST / DEF_QUEUE из graphs/):
+
+   DEF_VECTOR(IntVector, int)   →   typedef struct {
+                                        int* data;
+                                        int size;
+                                        int capacity;
+                                    } IntVector;
+   ФУНКЦИИ (static inline, префикс - имя вектора):
+   void Name_create(Name* v, int sz)               N → V_T,In
+   void Name_destroy(Name* v)                      V_T,In → ∅
+   bool Name_empty(const Name* v)                  V_T,In → boolean
+   int Name_size(const Name* v)                    V_T,In → N
+   Type Name_load(const Name* v, int i)            V_T,In × In → T
+   void Name_save(Name* v, int i, Type t)          V_T,In × In × T → V_T,In
+   Type* Name_at(Name* v, int i)                   V_T,In × In → T*
+   void Name_resize(Name* v, int sz)               V_T,In × N → V_T,Im
+   bool Name_equal(const Name* l, const Name* r)   V_T,In × V_T,In → boolean
+   void Name_push_back(Name* v, Type t)            V_T,In × T → V_T,In+1
+   void Name_pop_back(Name* v)                     V_T,In → V_T,In-1
+   void Name_reserve(Name* v, int cap)             V_T,In × N → V_T,In
+   void Name_shrink_to_fit(Name* v)                V_T,In → V_T,In
+   void Name_append(Name* v, const Type* src, int n)  V_T,In × T^m → V_T,In+m
+   ============================================================
+
+   Зачем, если есть vct.c с typedef void* T:
+   - int в void* занимает 8 байт вместо 4 и требует приведений
+   - Структура в void* - это указатель на неё: лишнее обращение к памяти
+     и отдельный malloc на каждый элемент
+   - Type* data - непрерывный массив значений: компилятор видит тип
+     и может векторизовать циклы по нему (SIMD)
+   - static inline: вызовы Name_load / Name_push_back встраиваются
+     и стоят как прямой доступ к массиву
+
+   Поведение совпадает с vct.c: рост вместимости вдвое, новые элементы
+   обнуляются, Name_load за границей возвращает нулевое значение Type
+*/
+
+// Начальная вместимость при первом росте пустого вектора
+#ifndef VECTOR_MIN_CAPACITY
+#define VECTOR_MIN_CAPACITY 8
+#endif
+
+#define DEF_VECTOR(Name, Type)                                                 \
+                                                                               \
+typedef struct {                                                               \
+    Type* data;                                                                \
+    int size;                                                                  \
+    int capacity;                                                              \
+} Name;                                                                        \
+                                                                               \
+/* Перевыделить память ровно под cap элементов */                             \
+static inline void Name##_set_capacity(Name* v, int cap)                       \
+{                                                                              \
+    if(cap == 0) {                                                             \
+        free(v->data);                                                         \
+        v->data = NULL;                                                        \
+    } else {                                                                   \
+        v->data = (Type*)realloc(v->data, sizeof(Type) * cap);                 \
+    }                                                                          \
+    v->capacity = cap;                                                         \
+}                                                                              \
+                                                                               \
+/* Место хотя бы под need элементов, рост вдвое */                            \
+static inline void Name##_grow(Name* v, int need)                              \
+{                                                                              \
+    if(need <= v->capacity)                                                    \
+        return;                                                                \
+    int cap = v->capacity ? v->capacity * 2 : VECTOR_MIN_CAPACITY;             \
+    if(cap < need)                                                             \
+        cap = need;                                                            \
+    Name##_set_capacity(v, cap);                                               \
+}                                                                              \
+                                                                               \
+static inline void Name##_create(Name* v, int sz)                              \
+{                                                                              \
+    v->size = sz;                                                              \
+    v->capacity = sz;                                                          \
+    v->data = (sz > 0) ? (Type*)calloc(sz, sizeof(Type)) : NULL;               \
+}                                                                              \
+                                                                               \
+static inline void Name##_destroy(Name* v)                                     \
+{                                                                              \
+    free(v->data);                                                             \
+    v->data = NULL;                                                            \
+    v->size = 0;                                                               \
+    v->capacity = 0;                                                           \
+}                                                                              \
+                                                                               \
+static inline bool Name##_empty(const Name* v)                                 \
+{                                                                              \
+    return v->size == 0;                                                       \
+}                                                                              \
+                                                                               \
+static inline int Name##_size(const Name* v)                                   \
+{                                                                              \
+    return v->size;                                                            \
+}                                                                              \
+                                                                               \
+static inline Type Name##_load(const Name* v, int i)                           \
+{                                                                              \
+    if((i >= 0) && (i < v->size))                                              \
+        return v->data[i];                                                     \
+    Type zero;                                                                 \
+    memset(&zero, 0, sizeof(zero));                                            \
+    return zero;                                                               \
+}                                                                              \
+                                                                               \
+static inline void Name##_save(Name* v, int i, Type t)                         \
+{                                                                              \
+    if((i >= 0) && (i < v->size))                                              \
+        v->data[i] = t;                                                        \
+}                                                                              \
+                                                                               \
+/* Указатель на элемент (NULL за границей) - для изменения на месте */       \
+static inline Type* Name##_at(Name* v, int i)                                  \
+{                                                                              \
+    return ((i >= 0) && (i < v->size)) ? &v->data[i] : NULL;                   \
+}                                                                              \
+                                                                               \
+static inline void Name##_resize(Name* v, int sz)                              \
+{                                                                              \
+    Name##_grow(v, sz);                                                        \
+    if(sz > v->size)                                                           \
+        memset(v->data + v->size, 0, sizeof(Type) * (sz - v->size));          \
+    v->size = sz;                                                              \
+}                                                                              \
+                                                                               \
+/* Побайтовое сравнение: для структур с выравниванием (дырами) */            \
+/* создавайте элементы через memset/calloc */                                \
+static inline bool Name##_equal(const Name* l, const Name* r)                  \
+{                                                                              \
+    if(l->size != r->size)                                                     \
+        return false;                                                          \
+    return l->size == 0 ||                                                     \
+           memcmp(l->data, r->data, sizeof(Type) * l->size) == 0;              \
+}                                                                              \
+                                                                               \
+static inline void Name##_push_back(Name* v, Type t)                           \
+{                                                                              \
+    Name##_grow(v, v->size + 1);                                               \
+    v->data[v->size++] = t;                                                    \
+}                                                                              \
+                                                                               \
+static inline void Name##_pop_back(Name* v)                                    \
+{                                                                              \
+    if(v->size)                                                                \
+        v->size--;                                                             \
+}                                                                              \
+                                                                               \
+static inline void Name##_reserve(Name* v, int cap)                            \
+{                                                                              \
+    if(cap > v->capacity)                                                      \
+        Name##_set_capacity(v, cap);                                           \
+}                                                                              \
+                                                                               \
+static inline void Name##_shrink_to_fit(Name* v)                               \
+{                                                                              \
+    if(v->capacity > v->size)                                                  \
+        Name##_set_capacity(v, v->size);                                       \
+}                                                                              \
+                                                                               \
+/* src может указывать в сам вектор - пересчитываем после realloc */           \
+static inline void Name##_append(Name* v, const Type* src, int n)              \
+{                                                                              \
+    if(n <= 0)                                                                 \
+        return;                                                                \
+    uintptr_t s = (uintptr_t)src;                                              \
+    uintptr_t b = (uintptr_t)v->data;                                          \
+    bool inside = v->data && s >= b && s < b + sizeof(Type) * v->size;         \
+    size_t offset = inside ? (s - b) / sizeof(Type) : 0;                       \
+    Name##_grow(v, v->size + n);                                               \
+    if(inside)                                                                 \
+        src = v->data + offset;                                                \
+    memcpy(v->data + v->size, src, sizeof(Type) * n);                          \
+    v->size += n;                                                              \
+}
+
+#endif
+
+// ============ СЛОЖНОСТЬ ============
+// Те же, что у vct.c:
+// Name_load / Name_save / Name_at: O(1)
+// Name_push_back: O(1) амортизированно
+// Name_append: O(m) - одно копирование
+// Name_resize, Name_reserve, Name_shrink_to_fit: O(n) при перевыделении
+// Name_equal: O(n) - одно сравнение memcmp
+// Память: sizeof(Type) · capacity - без указателей на каждый элемент
+//
+// Каждый DEF_VECTOR порождает свой набор функций: один раз на тип
+// в единице трансляции (как шаблоны C++)
+
+// ============ ПРИМЕР ИСПОЛЬЗОВАНИЯ ============
+
+/*
+#include <stdio.h>
+#include <time.h>
+#include "vct.c"
+
+typedef struct {
+    double x, y;
+} Point;
+
+DEF_VECTOR(IntVector, int)      // вектор int: 4 байта на элемент
+DEF_VECTOR(Points, Point)       // структуры хранятся по значению
+
+int main() {
+    printf("=== Типизированный вектор (DEF_VECTOR) ===\n\n");
+
+    // Тест 1: Вектор int без приведений к указателю
+    IntVector v;
+    IntVector_create(&v, 0);
+    for (int i = 0; i < 10; i++)
+        IntVector_push_back(&v, i * i);
+    printf("Тест 1: size=%d, v[3]=%d, v[9]=%d\n",
+           IntVector_size(&v), IntVector_load(&v, 3),
+           IntVector_load(&v, 9)); // 10, 9, 81
+
+    // Тест 2: Структуры по значению, изменение на месте
+    Points pts;
+    Points_create(&pts, 0);
+    Point p = {1.5, 2.5};
+    Points_push_back(&pts, p);
+    Points_at(&pts, 0)->x = 10;
+    printf("Тест 2: (%.1f, %.1f)\n", Points_load(&pts, 0).x,
+           Points_load(&pts, 0).y); // (10.0, 2.5)
+
+    // Тест 3: append и equal
+    IntVector w;
+    IntVector_create(&w, 0);
+    IntVector_append(&w, v.data, v.size);
+    printf("Тест 3: равны? %s\n", IntVector_equal(&v, &w) ? "Да" : "Нет"); // Да
+
+    // Тест 4: Память и скорость против void*-вектора из vct.c
+    int n = 10000000;
+    Vector generic;
+    Create(&generic, 0);
+    IntVector typed;
+    IntVector_create(&typed, 0);
+
+    clock_t t0 = clock();
+    for (int i = 0; i < n; i++)
+        PushBack(&generic, (void*)(long)i);
+    long long s1 = 0;
+    for (int i = 0; i < n; i++)
+        s1 += (long)Load(&generic, i);
+    double tGeneric = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    for (int i = 0; i < n; i++)
+        IntVector_push_back(&typed, i);
+    long long s2 = 0;
+    for (int i = 0; i < n; i++)
+        s2 += typed.data[i];  // цикл по int* - векторизуется
+    double tTyped = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("Тест 4: %d элементов\n", n);
+    printf("void* вектор: %zu МБ, %.3f с\n",
+           generic.capacity * sizeof(T) >> 20, tGeneric);
+    printf("IntVector:    %zu МБ, %.3f с\n",
+           typed.capacity * sizeof(int) >> 20, tTyped);
+    printf("Суммы совпадают? %s\n", s1 == s2 ? "Да" : "Нет");
+
+    IntVector_destroy(&v);
+    IntVector_destroy(&w);
+    IntVector_destroy(&typed);
+    Points_destroy(&pts);
+    Destroy(&generic);
+    return 0;
+}
+*/